@@ -0,0 +1,660 @@
+// Ѱ·㷨׼ԣͼν棬ʱMAZE_HEADLESSraylib
+// ÷ʾ
+//   MazeBench --sizes 20x20,100x100,1000x1000 --walls 0.25 --grass 0.1 --lava 0.02 --reps 21
+//   MazeBench --gen kruskal --sizes 10001x10001 --braid 0.1 --threads 8 --reps 5
+//   MazeBench --file ../MazeGameProject/maze20x20.txt --csv bench.csv --json bench.json
+//   MazeBench --sizes 1000x1000 --stats-log stats.jsonl
+//   MazeBench --sizes 1000x1000 --moves 8 --algos 2,5,6
+//   MazeBench --gen kruskal --sizes 201x201 --braid 0.3 --crowd 10000 --crowd-threads 1
+//   MazeBench --gen kruskal --sizes 1001x1001 --braid 0.1 --algos 6,9 --batch 2000 --threads 8
+#include "maze_data.h"
+#include "maze_utils.h"
+#include "maze_algorithms.h"
+#include "maze_generate.h"
+#include "maze_stats.h"
+#include "maze_field.h"
+#include "maze_crowd.h"
+#include "maze_batch.h"
+#include <string.h>
+#include <chrono>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+constexpr int BENCH_MAX_MAZES = 32;
+constexpr int BENCH_MAX_RESULTS = BENCH_MAX_MAZES * ALGO_COUNT;
+
+// Թļأ򰴳ߴ/α
+typedef struct {
+    char file[260];        // ļ·Ϊձʾɣ
+    int rows;              // ɵ
+    int cols;              // ɵ
+} BenchMazeSpec;
+
+// в
+typedef struct {
+    BenchMazeSpec mazes[BENCH_MAX_MAZES];
+    int mazeCount;
+    int generator;         // 㷨-1Ϊɢǽ
+    double braid;          // Թʱͨ·ı
+    int threads;           // Թ߳
+    double wallDensity;    // ǽıɢǽʱʹã
+    double grassRatio;     // ݵر
+    double lavaRatio;      // ұ
+    unsigned long long seed;
+    int reps;              // ÿ㷨ļʱ
+    int scanLimit;         // O(V05)ɨDijkstraֻڸֵʱ
+    bool algoEnabled[ALGO_COUNT];
+    MazeMovement movement; // ƶʽָ֧÷ʽ㷨
+    PathEncoding pathEncoding; // ·Ĵ洢ʽ
+    const char* csvPath;
+    const char* jsonPath;
+    const char* statsLogPath;  // ÿ㷨״ͳ׷ӵ־
+    int crowd;             // Ⱥģʷķ0ʾ⣩
+    int crowdThreads;      // Ⱥµ߳
+    int batch;             // Ĳѯ0ʾ⣩
+} BenchOptions;
+
+// 㷨ڵԹϵĲԽ
+typedef struct {
+    char maze[260];
+    int rows;
+    int cols;
+    MazeAlgorithm algo;
+    int reps;
+    bool found;
+    double medianMs;
+    double p99Ms;
+    double minMs;
+    double meanMs;
+    int expanded;
+    int pathLength;
+    long long pathCost;
+    size_t pathBytes;      // ·洢ռõֽ
+    size_t workspaceBytes;
+    size_t peakBytes;
+    SearchStats stats;     // ״ͳƣĹڴ棩
+} BenchResult;
+
+// ԹϽǡյ½ǣڳһͨ·֤ɴ
+static Maze* BenchGenerateMaze(int rows, int cols, const BenchOptions* opt, unsigned long long seed) {
+    Maze* maze = MazeCreate();
+    if (maze == NULL) return NULL;
+    if (!MazeAllocate(maze, rows, cols)) {
+        MazeDestroy(maze);
+        return NULL;
+    }
+
+    unsigned long long state = seed;
+    double grassEdge = opt->wallDensity + opt->grassRatio;
+    double lavaEdge = grassEdge + opt->lavaRatio;
+    size_t total = (size_t)rows * cols;
+    for (size_t i = 0; i < total; i++) {
+        double r = MazeRandomUnit(&state);
+        if (r < opt->wallDensity) maze->grid[i] = CELL_WALL;
+        else if (r < grassEdge) maze->grid[i] = CELL_GRASS;
+        else if (r < lavaEdge) maze->grid[i] = CELL_LAVA;
+        else maze->grid[i] = CELL_GROUND;
+    }
+
+    // ͨ·ϵǽΪͨ棨ݵ/ңʹ̳ɱ壩
+    int x = 0, y = 0;
+    while (x != cols - 1 || y != rows - 1) {
+        bool right = (y == rows - 1) || (x != cols - 1 && (MazeRandom(&state) & 1));
+        if (right) x++;
+        else y++;
+        signed char* cell = &maze->grid[MazeIndex(maze, x, y)];
+        if (*cell == CELL_WALL) *cell = CELL_GROUND;
+    }
+
+    maze->start.x = 0;
+    maze->start.y = 0;
+    maze->end.x = cols - 1;
+    maze->end.y = rows - 1;
+    maze->grid[MazeIndex(maze, 0, 0)] = CELL_START;
+    maze->grid[MazeIndex(maze, cols - 1, rows - 1)] = CELL_END;
+    return maze;
+}
+
+// ̷ֵڴ棨ֽڣȡʧʱΪ0
+static size_t PeakMemoryBytes() {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return counters.PeakWorkingSetSize;
+    }
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (size_t)usage.ru_maxrss;
+#else
+    return (size_t)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+// 򣨲򣬼ʱࣩ
+static void SortDoubles(double* values, int count) {
+    for (int i = 1; i < count; i++) {
+        double v = values[i];
+        int j = i - 1;
+        while (j >= 0 && values[j] > v) {
+            values[j + 1] = values[j];
+            j--;
+        }
+        values[j + 1] = v;
+    }
+}
+
+// ȷٷλvalues
+static double Percentile(const double* values, int count, double p) {
+    int rank = (int)(p * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return values[rank - 1];
+}
+
+// һԹһ㷨ԤһΣɹİ䣩ټʱrepsΣÿζǴͷ
+static bool BenchRunAlgorithm(Maze* maze, MazeAlgorithm algo, const BenchOptions* opt, MazePath* path, double* samples, BenchResult* res) {
+    PathData* pd = PathDataCreate(maze);
+    if (pd == NULL) return false;
+
+    res->algo = algo;
+    res->reps = opt->reps;
+    res->found = MazeSolveWith(maze, pd, algo, opt->movement, DEFAULT_TERRAIN_COST);
+    res->expanded = pd->expanded;
+    res->stats = pd->stats;
+    res->pathLength = 0;
+    res->pathCost = 0;
+    res->pathBytes = 0;
+    if (res->found) {
+        res->pathLength = PathBacktrack(maze, pd, path);
+        res->pathBytes = path->bytes;
+        res->pathCost = MazePathCost(maze, path, opt->movement, DEFAULT_TERRAIN_COST);
+    }
+
+    double sum = 0.0;
+    for (int r = 0; r < opt->reps; r++) {
+        auto t0 = std::chrono::steady_clock::now();
+        // D* Liteϴε״̬Թʱٴֻǿյع滮ÿȶ״̬ͷ滮㷨ɱ
+        if (pd->dstar != NULL) DStarReset(pd->dstar, maze->start, maze->end);
+        MazeSolveWith(maze, pd, algo, opt->movement, DEFAULT_TERRAIN_COST);
+        auto t1 = std::chrono::steady_clock::now();
+        samples[r] = std::chrono::duration<double, std::milli>(t1 - t0).count();
+        sum += samples[r];
+    }
+    SortDoubles(samples, opt->reps);
+    res->minMs = samples[0];
+    res->medianMs = Percentile(samples, opt->reps, 0.5);
+    res->p99Ms = Percentile(samples, opt->reps, 0.99);
+    res->meanMs = sum / opt->reps;
+    res->workspaceBytes = PathDataMemoryBytes(pd);
+    res->peakBytes = PeakMemoryBytes();
+
+    PathDataDestroy(maze, pd);
+    return true;
+}
+
+// "x"ʽĳߴбŷָ
+static bool ParseSizes(const char* text, BenchOptions* opt) {
+    const char* p = text;
+    while (*p != '\0') {
+        char* endPtr;
+        long rows = strtol(p, &endPtr, 10);
+        if (endPtr == p || (*endPtr != 'x' && *endPtr != 'X')) return false;
+        p = endPtr + 1;
+        long cols = strtol(p, &endPtr, 10);
+        if (endPtr == p || rows < 2 || cols < 2 || rows > 100000 || cols > 100000 || (long long)rows * cols > INT_MAX) return false;
+        p = endPtr;
+        if (opt->mazeCount >= BENCH_MAX_MAZES) return false;
+        BenchMazeSpec* spec = &opt->mazes[opt->mazeCount++];
+        spec->file[0] = '\0';
+        spec->rows = (int)rows;
+        spec->cols = (int)cols;
+        if (*p == ',') p++;
+        else if (*p != '\0') return false;
+    }
+    return true;
+}
+
+// ȽַASCIIСд
+static bool EqualsIgnoreCase(const char* a, const char* b) {
+    for (; *a != '\0' && *b != '\0'; a++, b++) {
+        char ca = (*a >= 'A' && *a <= 'Z') ? (char)(*a - 'A' + 'a') : *a;
+        char cb = (*b >= 'A' && *b <= 'Z') ? (char)(*b - 'A' + 'a') : *b;
+        if (ca != cb) return false;
+    }
+    return *a == *b;
+}
+
+// 㷨бŷָϷеּһ£
+static bool ParseAlgorithms(const char* text, BenchOptions* opt) {
+    for (int a = 0; a < ALGO_COUNT; a++) {
+        opt->algoEnabled[a] = false;
+    }
+    const char* p = text;
+    while (*p != '\0') {
+        char* endPtr;
+        long a = strtol(p, &endPtr, 10);
+        if (endPtr == p || a <= ALGO_NONE || a >= ALGO_COUNT) return false;
+        opt->algoEnabled[a] = true;
+        p = endPtr;
+        if (*p == ',') p++;
+        else if (*p != '\0') return false;
+    }
+    return true;
+}
+
+// ɷʽƣִСд
+static bool ParseGenerator(const char* text, BenchOptions* opt) {
+    if (EqualsIgnoreCase(text, "random")) {
+        opt->generator = -1;
+        return true;
+    }
+    for (int g = 0; g < GEN_COUNT; g++) {
+        if (EqualsIgnoreCase(text, MazeGeneratorName((MazeGenerator)g))) {
+            opt->generator = g;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool ParseMovement(const char* text, BenchOptions* opt) {
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        if (EqualsIgnoreCase(text, MazeMovementName((MazeMovement)m))) {
+            opt->movement = (MazeMovement)m;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool ParsePathEncoding(const char* text, BenchOptions* opt) {
+    for (int e = 0; e < PATH_ENCODING_COUNT; e++) {
+        if (EqualsIgnoreCase(text, PathEncodingName((PathEncoding)e))) {
+            opt->pathEncoding = (PathEncoding)e;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void PrintUsage() {
+    printf("÷: MazeBench [ѡ]\n");
+    printf("  --sizes RxC[,RxC...]  Թĳߴ磨Ĭ20x20,100x100,1000x1000ɴ10000x10000\n");
+    printf("  --file PATH           ļԹظı/Ƹʽɣ\n");
+    printf("  --gen NAME            ԹɷʽrandomɢǽĬϣ");
+    for (int g = 0; g < GEN_COUNT; g++) {
+        printf("/%s", MazeGeneratorName((MazeGenerator)g));
+    }
+    printf("\n");
+    printf("  --braid F             Թʱͨ·ıĬ0\n");
+    printf("  --threads N           Թ߳Ĭ0ȫӲ̣߳\n");
+    printf("  --walls F             ǽıĬ0.25random\n");
+    printf("  --grass F             ݵرĬ0.10\n");
+    printf("  --lava F              ұĬ0.02\n");
+    printf("  --seed N              ӣĬ1\n");
+    printf("  --reps N              ÿ㷨ʱĬ21\n");
+    printf("  --algos N[,N...]      㷨ţ");
+    for (int a = ALGO_NONE + 1; a < ALGO_COUNT; a++) {
+        printf("%s%d=%s", a > 1 ? " " : "", a, MazeAlgorithmName((MazeAlgorithm)a));
+    }
+    printf("Ĭȫ\n");
+    printf("  --moves M             ƶʽ4Ĭϣ/8˷򣬲ǽǣ/8cut˷ǽǣ\n");
+    printf("  --path-encoding E     ·洢ʽpoints/directionsĬϣ/runs\n");
+    printf("  --scan-limit N        ɨDijkstraĸޣĬ40000\n");
+    printf("  --csv PATH            дCSVļ\n");
+    printf("  --json PATH           дJSONļ\n");
+    printf("  --stats-log PATH      㷨ͳ׷ӵ־.json/.jsonlΪJSON LinesΪCSV\n");
+    printf("  --crowd N             Nֻʷķ׷յȺºʱÿ֡1/60룬600֡\n");
+    printf("  --crowd-threads N     Ⱥµ߳Ĭ10ΪȫӲ̣߳\n");
+    printf("  --batch Q             Q/յѯ1߳--threads̸߳һΣڽӣ\n");
+}
+
+static bool ParseOptions(int argc, char** argv, BenchOptions* opt) {
+    opt->mazeCount = 0;
+    opt->generator = -1;
+    opt->braid = 0.0;
+    opt->threads = 0;
+    opt->wallDensity = 0.25;
+    opt->grassRatio = 0.10;
+    opt->lavaRatio = 0.02;
+    opt->seed = 1;
+    opt->reps = 21;
+    opt->scanLimit = 40000;
+    for (int a = 0; a < ALGO_COUNT; a++) {
+        opt->algoEnabled[a] = (a != ALGO_NONE);
+    }
+    opt->movement = MOVE_4;
+    opt->pathEncoding = PATH_DIRECTIONS;
+    opt->csvPath = NULL;
+    opt->jsonPath = NULL;
+    opt->statsLogPath = NULL;
+    opt->crowd = 0;
+    opt->crowdThreads = 1;
+    opt->batch = 0;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) return false;
+        if (i + 1 >= argc) {
+            TraceLog(LOG_ERROR, "ȱȡֵ: %s", arg);
+            return false;
+        }
+        const char* value = argv[++i];
+        bool ok = true;
+        if (strcmp(arg, "--sizes") == 0) ok = ParseSizes(value, opt);
+        else if (strcmp(arg, "--file") == 0) {
+            ok = opt->mazeCount < BENCH_MAX_MAZES && strlen(value) < sizeof(opt->mazes[0].file);
+            if (ok) {
+                BenchMazeSpec* spec = &opt->mazes[opt->mazeCount++];
+                memcpy(spec->file, value, strlen(value) + 1);
+                spec->rows = 0;
+                spec->cols = 0;
+            }
+        }
+        else if (strcmp(arg, "--gen") == 0) ok = ParseGenerator(value, opt);
+        else if (strcmp(arg, "--braid") == 0) opt->braid = atof(value);
+        else if (strcmp(arg, "--threads") == 0) opt->threads = atoi(value);
+        else if (strcmp(arg, "--walls") == 0) opt->wallDensity = atof(value);
+        else if (strcmp(arg, "--grass") == 0) opt->grassRatio = atof(value);
+        else if (strcmp(arg, "--lava") == 0) opt->lavaRatio = atof(value);
+        else if (strcmp(arg, "--seed") == 0) opt->seed = strtoull(value, NULL, 10);
+        else if (strcmp(arg, "--reps") == 0) ok = (opt->reps = atoi(value)) > 0;
+        else if (strcmp(arg, "--algos") == 0) ok = ParseAlgorithms(value, opt);
+        else if (strcmp(arg, "--moves") == 0) ok = ParseMovement(value, opt);
+        else if (strcmp(arg, "--path-encoding") == 0) ok = ParsePathEncoding(value, opt);
+        else if (strcmp(arg, "--scan-limit") == 0) opt->scanLimit = atoi(value);
+        else if (strcmp(arg, "--csv") == 0) opt->csvPath = value;
+        else if (strcmp(arg, "--json") == 0) opt->jsonPath = value;
+        else if (strcmp(arg, "--stats-log") == 0) opt->statsLogPath = value;
+        else if (strcmp(arg, "--crowd") == 0) ok = (opt->crowd = atoi(value)) >= 0;
+        else if (strcmp(arg, "--crowd-threads") == 0) opt->crowdThreads = atoi(value);
+        else if (strcmp(arg, "--batch") == 0) ok = (opt->batch = atoi(value)) >= 0;
+        else {
+            TraceLog(LOG_ERROR, "δ֪: %s", arg);
+            return false;
+        }
+        if (!ok) {
+            TraceLog(LOG_ERROR, "ȡֵǷ: %s %s", arg, value);
+            return false;
+        }
+    }
+
+    if (opt->wallDensity < 0.0 || opt->grassRatio < 0.0 || opt->lavaRatio < 0.0 ||
+        opt->wallDensity + opt->grassRatio + opt->lavaRatio > 1.0) {
+        TraceLog(LOG_ERROR, "αǷǸܺͲ1");
+        return false;
+    }
+    if (opt->mazeCount == 0) ParseSizes("20x20,100x100,1000x1000", opt);
+    return true;
+}
+
+// Ⱥģ⣺ܵյĸʷķյΪĿ갴ÿ֡1/60£ͳÿ֡ʱ
+static bool BenchRunCrowd(Maze* maze, const BenchOptions* opt, const char* label) {
+    const int frames = 600;
+    DistanceField* field = DistanceFieldCreate(maze);
+    Crowd* crowd = CrowdCreate(opt->crowd, opt->crowdThreads);
+    double* samples = (double*)malloc(frames * sizeof(double));
+    bool ok = field != NULL && crowd != NULL && samples != NULL && DistanceFieldUpdate(field, maze, maze->end, DEFAULT_TERRAIN_COST);
+    if (ok) {
+        unsigned long long state = opt->seed;
+        for (int attempt = 0; crowd->count < opt->crowd && attempt < opt->crowd * 100; attempt++) {
+            Point p = { (int)(MazeRandom(&state) % (unsigned long long)maze->cols), (int)(MazeRandom(&state) % (unsigned long long)maze->rows) };
+            if (DistanceFieldCost(field, p) != INT_MAX) CrowdAdd(crowd, p);
+        }
+        for (int f = 0; f < frames; f++) {
+            CrowdUpdate(crowd, maze, field, 1.0f / 60.0f);
+            samples[f] = crowd->milliseconds;
+        }
+        double mean = 0.0;
+        for (int f = 0; f < frames; f++) mean += samples[f];
+        mean /= frames;
+        SortDoubles(samples, frames);
+        char name[32];
+        snprintf(name, sizeof(name), "Crowd(%d)", crowd->count);
+        printf("%-24s %-17s %10.3f %10.3f   mean %.3fms/frame, %d thread(s)\n", label, name,
+            Percentile(samples, frames, 0.5), Percentile(samples, frames, 0.99), mean,
+            crowd->pool != NULL ? ParallelPoolThreadCount(crowd->pool) : 1);
+        fflush(stdout);
+    }
+    else {
+        TraceLog(LOG_ERROR, "Ⱥģ׼ʧ: %s", label);
+    }
+    free(samples);
+    CrowdDestroy(crowd);
+    DistanceFieldDestroy(field);
+    return ok;
+}
+
+// ߳һѯѯԤȸ̵߳Ĺÿѯʧܷ0
+static double BenchBatchThroughput(Maze* maze, MazeAlgorithm algo, int threads, const MazeQuery* queries,
+    MazeQueryResult* results, int count, int* workers, int* found, double* setupMs) {
+    auto t0 = std::chrono::steady_clock::now();
+    MazeBatchSolver* solver = MazeBatchCreate(maze, algo, threads);
+    if (solver == NULL) return 0.0;
+    auto t1 = std::chrono::steady_clock::now();
+    *setupMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    *workers = solver->workerCount;
+    int warmup = solver->workerCount * 4 < count ? solver->workerCount * 4 : count;
+    MazeBatchSolve(solver, queries, results, warmup);
+
+    auto t2 = std::chrono::steady_clock::now();
+    *found = MazeBatchSolve(solver, queries, results, count);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t2).count();
+    MazeBatchDestroy(solver);
+    return seconds > 0.0 ? count / seconds : 0.0;
+}
+
+// ͬһѯ㡢յΪͨиӣֱ1߳--threads߳⣬
+// Ƚÿѯɼ̵߳ļٱ
+static bool BenchRunBatch(Maze* maze, const BenchOptions* opt, const char* label) {
+    if (opt->movement != MOVE_4) {
+        TraceLog(LOG_ERROR, "ֻ֧ڽӣ: %s", label);
+        return false;
+    }
+    MazeQuery* queries = (MazeQuery*)malloc((size_t)opt->batch * sizeof(MazeQuery));
+    MazeQueryResult* results = (MazeQueryResult*)calloc((size_t)opt->batch, sizeof(MazeQueryResult));
+    bool ok = queries != NULL && results != NULL;
+    unsigned long long state = opt->seed;
+    int passable = 0;
+    size_t total = (size_t)maze->rows * maze->cols;
+    for (size_t i = 0; ok && i < total; i++) {
+        if (maze->grid[i] != CELL_WALL) passable++;
+    }
+    ok = ok && passable > 0;
+    for (int q = 0; ok && q < opt->batch; q++) {
+        Point* ends[2] = { &queries[q].start, &queries[q].end };
+        for (int k = 0; k < 2; k++) {
+            do {
+                ends[k]->x = MazeRandomBelow(&state, maze->cols);
+                ends[k]->y = MazeRandomBelow(&state, maze->rows);
+            } while (MazeGetCell(maze, ends[k]->x, ends[k]->y) == CELL_WALL);
+        }
+    }
+    if (!ok) {
+        TraceLog(LOG_ERROR, "׼ʧ: %s", label);
+        free(queries);
+        free(results);
+        return false;
+    }
+
+    for (int a = ALGO_NONE + 1; a < ALGO_COUNT; a++) {
+        if (!opt->algoEnabled[a]) continue;
+        if (a == ALGO_DIJKSTRA && total > (size_t)opt->scanLimit) continue;
+        int serialWorkers, serialFound, workers, found;
+        double serialSetup, setup;
+        double serial = BenchBatchThroughput(maze, (MazeAlgorithm)a, 1, queries, results, opt->batch, &serialWorkers, &serialFound, &serialSetup);
+        double parallel = BenchBatchThroughput(maze, (MazeAlgorithm)a, opt->threads, queries, results, opt->batch, &workers, &found, &setup);
+        if (serial <= 0.0 || parallel <= 0.0) {
+            TraceLog(LOG_ERROR, "ʧ: %s %s", label, MazeAlgorithmName((MazeAlgorithm)a));
+            continue;
+        }
+        char name[32];
+        snprintf(name, sizeof(name), "Batch(%d)", opt->batch);
+        printf("%-24s %-17s %-17s %10.0f q/s on %d thread(s) (setup %.1fms), %.0f q/s on 1 thread (setup %.1fms), speedup %.2fx, found %d\n",
+            label, name, MazeAlgorithmName((MazeAlgorithm)a), parallel, workers, setup, serial, serialSetup, parallel / serial, found);
+        fflush(stdout);
+    }
+    free(queries);
+    free(results);
+    return true;
+}
+
+static bool WriteCsv(const char* filename, const BenchResult* results, int count) {
+    FILE* file = MazeFileOpen(filename, "w");
+    if (file == NULL) {
+        TraceLog(LOG_ERROR, "޷дļ: %s", filename);
+        return false;
+    }
+    fprintf(file, "maze,rows,cols,algorithm,reps,found,median_ms,p99_ms,min_ms,mean_ms,expanded,path_length,path_cost,path_bytes,workspace_bytes,peak_bytes\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        fprintf(file, "\"%s\",%d,%d,\"%s\",%d,%d,%.4f,%.4f,%.4f,%.4f,%d,%d,%lld,%llu,%llu,%llu\n",
+            r->maze, r->rows, r->cols, MazeAlgorithmName(r->algo), r->reps, r->found ? 1 : 0,
+            r->medianMs, r->p99Ms, r->minMs, r->meanMs, r->expanded, r->pathLength, r->pathCost,
+            (unsigned long long)r->pathBytes, (unsigned long long)r->workspaceBytes, (unsigned long long)r->peakBytes);
+    }
+    return fclose(file) == 0;
+}
+
+// дJSONַת뷴бܣ
+static void WriteJsonString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', file);
+        fputc(*p, file);
+    }
+    fputc('"', file);
+}
+
+static bool WriteJson(const char* filename, const BenchOptions* opt, const BenchResult* results, int count) {
+    FILE* file = MazeFileOpen(filename, "w");
+    if (file == NULL) {
+        TraceLog(LOG_ERROR, "޷дļ: %s", filename);
+        return false;
+    }
+    fprintf(file, "{\n  \"schema\": 1,\n  \"generator\": \"%s\",\n  \"braid\": %.4f,\n  \"seed\": %llu,\n  \"walls\": %.4f,\n  \"grass\": %.4f,\n  \"lava\": %.4f,\n  \"movement\": \"%s\",\n  \"path_encoding\": \"%s\",\n  \"results\": [\n",
+        opt->generator < 0 ? "random" : MazeGeneratorName((MazeGenerator)opt->generator), opt->braid,
+        opt->seed, opt->wallDensity, opt->grassRatio, opt->lavaRatio, MazeMovementName(opt->movement),
+        PathEncodingName(opt->pathEncoding));
+    for (int i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        fprintf(file, "    {\"maze\": ");
+        WriteJsonString(file, r->maze);
+        fprintf(file, ", \"rows\": %d, \"cols\": %d, \"algorithm\": ", r->rows, r->cols);
+        WriteJsonString(file, MazeAlgorithmName(r->algo));
+        fprintf(file, ", \"reps\": %d, \"found\": %s, \"median_ms\": %.4f, \"p99_ms\": %.4f, \"min_ms\": %.4f, \"mean_ms\": %.4f, "
+            "\"expanded\": %d, \"path_length\": %d, \"path_cost\": %lld, \"path_bytes\": %llu, \"workspace_bytes\": %llu, \"peak_bytes\": %llu}%s\n",
+            r->reps, r->found ? "true" : "false", r->medianMs, r->p99Ms, r->minMs, r->meanMs,
+            r->expanded, r->pathLength, r->pathCost, (unsigned long long)r->pathBytes,
+            (unsigned long long)r->workspaceBytes, (unsigned long long)r->peakBytes, i + 1 < count ? "," : "");
+    }
+    fprintf(file, "  ]\n}\n");
+    return fclose(file) == 0;
+}
+
+int main(int argc, char** argv) {
+    BenchOptions opt;
+    if (!ParseOptions(argc, argv, &opt)) {
+        PrintUsage();
+        return 1;
+    }
+    // 㷨ڲÿ־ʱڼֻϢ
+    SetTraceLogLevel(LOG_ERROR);
+
+    static BenchResult results[BENCH_MAX_RESULTS];
+    int resultCount = 0;
+    double* samples = (double*)malloc((size_t)opt.reps * sizeof(double));
+    if (samples == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣʱ");
+        return 1;
+    }
+
+    printf("%-24s %-17s %10s %10s %10s %8s %10s %10s %12s\n",
+        "maze", "algorithm", "median_ms", "p99_ms", "expanded", "length", "cost", "path_B", "workspace_KB");
+    for (int m = 0; m < opt.mazeCount; m++) {
+        const BenchMazeSpec* spec = &opt.mazes[m];
+        Maze* maze = NULL;
+        char label[260];
+        if (spec->file[0] != '\0') {
+            maze = MazeCreate();
+            if (maze != NULL && !MazeLoadFromFile(maze, spec->file)) {
+                MazeDestroy(maze);
+                maze = NULL;
+            }
+            snprintf(label, sizeof(label), "%s", spec->file);
+        }
+        else {
+            if (opt.generator < 0) {
+                maze = BenchGenerateMaze(spec->rows, spec->cols, &opt, opt.seed + m);
+            }
+            else {
+                MazeGenOptions gen;
+                MazeGenOptionsDefault(&gen, spec->rows, spec->cols, opt.seed + m);
+                gen.algorithm = (MazeGenerator)opt.generator;
+                gen.braid = opt.braid;
+                gen.grassRatio = opt.grassRatio;
+                gen.lavaRatio = opt.lavaRatio;
+                gen.threads = opt.threads;
+                maze = MazeCreate();
+                if (maze != NULL && !MazeGenerate(maze, &gen)) {
+                    MazeDestroy(maze);
+                    maze = NULL;
+                }
+            }
+            snprintf(label, sizeof(label), "%s%dx%d",
+                opt.generator < 0 ? "random" : MazeGeneratorName((MazeGenerator)opt.generator), spec->rows, spec->cols);
+        }
+        if (maze == NULL) {
+            TraceLog(LOG_ERROR, "Թ׼ʧܣ: %s", label);
+            continue;
+        }
+
+        size_t total = (size_t)maze->rows * maze->cols;
+        MazePath path;
+        MazePathInit(&path, opt.pathEncoding);
+
+        for (int a = ALGO_NONE + 1; a < ALGO_COUNT; a++) {
+            if (!opt.algoEnabled[a]) continue;
+            if (a == ALGO_DIJKSTRA && total > (size_t)opt.scanLimit) continue;
+            if (!MazeAlgorithmSupports((MazeAlgorithm)a, opt.movement)) continue;
+            BenchResult* res = &results[resultCount];
+            snprintf(res->maze, sizeof(res->maze), "%s", label);
+            res->rows = maze->rows;
+            res->cols = maze->cols;
+            if (!BenchRunAlgorithm(maze, (MazeAlgorithm)a, &opt, &path, samples, res)) continue;
+            resultCount++;
+            printf("%-24s %-17s %10.3f %10.3f %10d %8d %10lld %10llu %12llu\n",
+                label, MazeAlgorithmName(res->algo), res->medianMs, res->p99Ms, res->expanded,
+                res->pathLength, res->pathCost, (unsigned long long)res->pathBytes, (unsigned long long)(res->workspaceBytes / 1024));
+            fflush(stdout);
+            if (opt.statsLogPath != NULL) {
+                SearchStatsRecord record = { label, res->rows, res->cols, res->algo, res->found, res->pathLength, res->expanded, res->stats };
+                SearchStatsAppend(opt.statsLogPath, &record);
+            }
+        }
+
+        if (opt.crowd > 0) BenchRunCrowd(maze, &opt, label);
+        if (opt.batch > 0) BenchRunBatch(maze, &opt, label);
+
+        MazePathFree(&path);
+        MazeDestroy(maze);
+    }
+    printf("peak memory: %llu KB\n", (unsigned long long)(PeakMemoryBytes() / 1024));
+    free(samples);
+
+    bool ok = true;
+    if (opt.csvPath != NULL) ok = WriteCsv(opt.csvPath, results, resultCount) && ok;
+    if (opt.jsonPath != NULL) ok = WriteJson(opt.jsonPath, &opt, results, resultCount) && ok;
+    return ok ? 0 : 1;
+}
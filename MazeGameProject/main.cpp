@@ -4,10 +4,38 @@
 #include "maze_config.h"
 #include "maze_textures.h"
 #include "maze_data.h"
+#include "maze_generate.h"
 #include "maze_utils.h"
 #include "maze_algorithms.h"
+#include "maze_async.h"
+#include "maze_search.h"
+#include "maze_stats.h"
+#include "maze_field.h"
+#include "maze_crowd.h"
 #include "maze_render.h"
 
+// 在远离玩家、且与玩家同一连通分量的随机可通行格子上放置一只史莱姆（分量索引为NULL时不限制）
+static bool SpawnSlime(Maze* maze, Point player, Crowd* crowd, const ComponentIndex* components) {
+    int playerIndex = MazeIndex(maze, player.x, player.y);
+    for (int attempt = 0; attempt < 100; attempt++) {
+        Point p = { GetRandomValue(0, maze->cols - 1), GetRandomValue(0, maze->rows - 1) };
+        CellType cell = MazeGetCell(maze, p.x, p.y);
+        if (cell == CELL_WALL || cell == CELL_LAVA) continue;
+        if (abs(p.x - player.x) + abs(p.y - player.y) < 6) continue;
+        if (components != NULL && !ComponentIndexConnected(components, maze, MazeIndex(maze, p.x, p.y), playerIndex)) continue;
+        return CrowdAdd(crowd, p);
+    }
+    return false;
+}
+
+// 增加count只史莱姆，返回实际增加的数量（分量索引取自分步搜索工作区，随地块修改同步）
+static int SpawnSlimes(Maze* maze, Point player, Crowd* crowd, PathData* pd, int count) {
+    const ComponentIndex* components = PathDataReserveComponents(pd, maze);
+    int added = 0;
+    while (added < count && SpawnSlime(maze, player, crowd, components)) added++;
+    return added;
+}
+
 int main() {
     // 初始化Raylib窗口
     InitWindow(WINDOW_WIDTH, WINDOW_HEIGHT, WINDOW_TITLE);
@@ -37,124 +65,329 @@ int main() {
         return 1;
     }
 
+    // 异步求解器（后台线程持有自己的迷宫副本与搜索工作区，求解期间照常渲染）
+    MazeAsyncSolver* solver = MazeAsyncCreate();
+    if (solver == NULL) {
+        TraceLog(LOG_ERROR, "异步求解器初始化失败，程序退出");
+        TexturesUnload(tex);
+        MazeDestroy(maze);
+        CloseWindow();
+        return 1;
+    }
+
+    // 分步搜索的工作区与路径（V键开启后在主线程逐帧推进；路径按2位方向流存储，随长度增长）
+    PathData* stepPd = PathDataCreate(maze);
+    MazePath stepPath;
+    MazePathInit(&stepPath, PATH_DIRECTIONS);
+    if (stepPd == NULL) {
+        TraceLog(LOG_ERROR, "分步搜索工作区初始化失败，程序退出");
+        MazeAsyncDestroy(solver);
+        TexturesUnload(tex);
+        MazeDestroy(maze);
+        CloseWindow();
+        return 1;
+    }
+
+    // 史莱姆追踪玩家的距离场（玩家不动、迷宫不变时不重算）
+    DistanceField* field = DistanceFieldCreate(maze);
+    if (field == NULL) {
+        TraceLog(LOG_ERROR, "距离场初始化失败，程序退出");
+        PathDataDestroy(maze, stepPd);
+        MazeAsyncDestroy(solver);
+        TexturesUnload(tex);
+        MazeDestroy(maze);
+        CloseWindow();
+        return 1;
+    }
+
+    // 史莱姆群体（SoA存储，每帧连续移动；CROWD_THREADS大于1时多线程更新）
+    Crowd* crowd = CrowdCreate(MAX_SLIMES, CROWD_THREADS);
+    if (crowd == NULL) {
+        TraceLog(LOG_ERROR, "史莱姆群体初始化失败，程序退出");
+        DistanceFieldDestroy(field);
+        PathDataDestroy(maze, stepPd);
+        MazeAsyncDestroy(solver);
+        TexturesUnload(tex);
+        MazeDestroy(maze);
+        CloseWindow();
+        return 1;
+    }
+
+    // 视图（滚轮缩放、右键拖动平移）、静态地形层（地形预渲染一次，之后只重绘变化的格子）与路径层（路径变化时切段一次）
+    MazeView view;
+    MazeViewInit(&view, maze);
+    TerrainLayer* terrain = TerrainLayerCreate(maze);
+    PathLayer* pathLayer = PathLayerCreate(maze);
+    if (terrain == NULL || pathLayer == NULL) {
+        TraceLog(LOG_ERROR, "地形层初始化失败，程序退出");
+        PathLayerDestroy(pathLayer);
+        TerrainLayerDestroy(terrain);
+        CrowdDestroy(crowd);
+        DistanceFieldDestroy(field);
+        PathDataDestroy(maze, stepPd);
+        MazeAsyncDestroy(solver);
+        TexturesUnload(tex);
+        MazeDestroy(maze);
+        CloseWindow();
+        return 1;
+    }
+
+    // 玩家与史莱姆
+    Point player = maze->start;
+    SpawnSlimes(maze, player, crowd, stepPd, INITIAL_SLIMES);
+
     // 路径相关变量
-    PathData* pd = NULL;
-    Point path[400]; // 存储路径（最大400个节点）
-    int pathLen = 0;
-    int algoType = 0; // 0=无路径, 1=DFS, 2=BFS, 3=Dijkstra
+    const MazeAsyncResult* shown = NULL; // 当前显示的结果（指向异步求解器的前台缓冲区）
+    MazeAlgorithm algoType = ALGO_NONE; // 最近一次请求的算法（修改地块后用它重新规划）
+    bool stepMode = false; // V键切换：支持分步执行的算法逐帧推进并显示搜索过程
+    MazeSearch search;
+    MazeSearchStop(&search);
+    MazePathIter follow;    // 角色沿路径自动行走的进度（F键开始）
+    bool following = false;
+    float followTimer = 0.0f;
+
+    MazeGenerator genAlgo = GEN_BACKTRACKER; // 下次按G键使用的生成算法
+    char mazeName[64] = "maze20x20.txt";     // 当前迷宫名称（写入统计日志）
+
+    // 数字键与算法的对应关系（KEY_ONE对应ALGO_DFS，依次类推）
+    const int algoKeys[ALGO_COUNT - 1] = { KEY_ONE, KEY_TWO, KEY_THREE, KEY_FOUR, KEY_FIVE, KEY_SIX, KEY_SEVEN, KEY_EIGHT, KEY_NINE, KEY_D, KEY_B, KEY_N };
 
     // 主循环
     while (!WindowShouldClose()) {
+        // 视图交互（更新可见范围）
+        MazeViewUpdate(&view, maze);
+
         // 按键交互逻辑
-        if (IsKeyPressed(KEY_ONE)) {
-            TraceLog(LOG_INFO, "执行DFS算法");
-            // 释放旧路径数据
-            if (pd != NULL) {
-                PathDataDestroy(maze, pd);
-                pd = NULL;
-            }
-            pd = PathDataCreate(maze);
-            if (pd == NULL) {
-                TraceLog(LOG_ERROR, "路径数据初始化失败");
-                pathLen = 0;
-                algoType = 0;
-                continue;
-            }
-            // 执行DFS（从起点开始）
-            if (DFS(maze, pd, maze->start.x, maze->start.y)) {
-                pathLen = PathBacktrack(maze, pd, path, 400);
-            }
-            else {
-                pathLen = 0;
-                TraceLog(LOG_WARNING, "DFS未找到有效路径");
+        MazeAlgorithm solveAlgo = ALGO_NONE; // 本帧需要执行的算法
+        for (int k = 0; k < ALGO_COUNT - 1; k++) {
+            if (IsKeyPressed(algoKeys[k])) solveAlgo = (MazeAlgorithm)(k + 1);
+        }
+
+        // 鼠标左键：切换墙/地面（起点、终点与角色所在格除外），已请求的路径用同一算法重新规划
+        Point clicked;
+        if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && GetCellFromPixel(&view, maze, GetMousePosition(), &clicked)) {
+            CellType cell = MazeGetCell(maze, clicked.x, clicked.y);
+            bool occupied = (clicked.x == player.x && clicked.y == player.y) || CrowdFindInCell(crowd, maze, clicked.x, clicked.y) >= 0;
+            if (cell != CELL_START && cell != CELL_END && !occupied) {
+                // 经分步搜索工作区修改（同步其连通分量索引）；后台线程在下次提交时从快照中同步这一格
+                PathDataSetCell(stepPd, maze, clicked.x, clicked.y, cell == CELL_WALL ? CELL_GROUND : CELL_WALL);
+                DistanceFieldInvalidate(field);
+                TerrainLayerMarkDirty(terrain, clicked.x, clicked.y);
+                if (algoType != ALGO_NONE) solveAlgo = algoType;
             }
-            algoType = 1;
         }
 
-        if (IsKeyPressed(KEY_TWO)) {
-            TraceLog(LOG_INFO, "执行BFS算法");
-            if (pd != NULL) {
-                PathDataDestroy(maze, pd);
-                pd = NULL;
+        if (IsKeyPressed(KEY_V)) {
+            stepMode = !stepMode;
+            TraceLog(LOG_INFO, "分步搜索：%s", stepMode ? "开启" : "关闭");
+        }
+
+        if (solveAlgo != ALGO_NONE) {
+            TraceLog(LOG_INFO, "执行%s算法", MazeAlgorithmName(solveAlgo));
+            MazeSearchStop(&search);
+            MazePathClear(&stepPath);
+            following = false;
+            if (stepMode && MazeSearchSupports(solveAlgo)) {
+                // 分步模式：在主线程从头开始，之后每帧按预算推进
+                MazeAsyncCancel(solver);
+                shown = NULL;
+                if (MazeSearchBegin(&search, maze, stepPd, solveAlgo, DEFAULT_TERRAIN_COST)) algoType = solveAlgo;
             }
-            pd = PathDataCreate(maze);
-            if (pd == NULL) {
-                TraceLog(LOG_ERROR, "路径数据初始化失败");
-                pathLen = 0;
-                algoType = 0;
-                continue;
+            // 提交到后台线程（取消尚未完成的上一个任务），结果出来之前继续显示旧路径
+            else if (MazeAsyncSubmit(solver, maze, solveAlgo) != 0) {
+                algoType = solveAlgo;
             }
-            // 执行BFS
-            if (BFS(maze, pd)) {
-                pathLen = PathBacktrack(maze, pd, path, 400);
+        }
+
+        if (IsKeyPressed(KEY_ZERO)) {
+            TraceLog(LOG_INFO, "清空路径");
+            MazeAsyncCancel(solver);
+            MazeSearchStop(&search);
+            shown = NULL;
+            MazePathClear(&stepPath);
+            following = false;
+            algoType = ALGO_NONE;
+        }
+
+        // L键：把当前显示的搜索统计追加到日志文件
+        if (IsKeyPressed(KEY_L) && (search.status != SEARCH_IDLE || shown != NULL)) {
+            SearchStatsRecord record;
+            if (search.status != SEARCH_IDLE) {
+                SearchStatsRecordFill(&record, mazeName, maze, search.algo, search.status == SEARCH_FOUND, stepPath.length, stepPd);
             }
             else {
-                pathLen = 0;
-                TraceLog(LOG_WARNING, "BFS未找到有效路径");
+                record.maze = mazeName;
+                record.rows = maze->rows;
+                record.cols = maze->cols;
+                record.algo = shown->algo;
+                record.found = shown->path.length > 0;
+                record.pathLength = shown->path.length;
+                record.expanded = shown->expanded;
+                record.stats = shown->stats;
             }
-            algoType = 2;
+            if (SearchStatsAppend(STATS_LOG_FILE, &record)) TraceLog(LOG_INFO, "搜索统计已写入%s", STATS_LOG_FILE);
         }
 
-        if (IsKeyPressed(KEY_THREE)) {
-            TraceLog(LOG_INFO, "执行Dijkstra算法");
-            if (pd != NULL) {
-                PathDataDestroy(maze, pd);
-                pd = NULL;
-            }
-            pd = PathDataCreate(maze);
-            if (pd == NULL) {
-                TraceLog(LOG_ERROR, "路径数据初始化失败");
-                pathLen = 0;
-                algoType = 0;
-                continue;
-            }
-            // 执行Dijkstra
-            if (Dijkstra(maze, pd)) {
-                pathLen = PathBacktrack(maze, pd, path, 400);
+        // 分步搜索推进一帧的预算，找到路径时回溯
+        if (search.status == SEARCH_RUNNING &&
+            MazeSearchStep(&search, SEARCH_NODES_PER_FRAME, SEARCH_FRAME_SECONDS) == SEARCH_FOUND) {
+            PathBacktrack(maze, stepPd, &stepPath);
+        }
+
+        // 轮询后台结果：完成时交换双缓冲，不加锁、不等待
+        const MazeAsyncResult* finished = MazeAsyncPoll(solver);
+        if (finished != NULL) {
+            if (finished->path.length == 0) TraceLog(LOG_WARNING, "%s未找到有效路径", MazeAlgorithmName(finished->algo));
+            shown = finished;
+            following = false;  // 前台缓冲区已交换，原路径不再有效
+        }
+
+        // 方向键移动玩家（不能穿墙）
+        Point move = player;
+        if (IsKeyPressed(KEY_UP)) move.y--;
+        else if (IsKeyPressed(KEY_DOWN)) move.y++;
+        else if (IsKeyPressed(KEY_LEFT)) move.x--;
+        else if (IsKeyPressed(KEY_RIGHT)) move.x++;
+        if (IsPointValid(maze, move.x, move.y) && MazeGetCell(maze, move.x, move.y) != CELL_WALL) {
+            player = move;
+        }
+
+        // F键：角色回到路径起点，沿当前显示的路径自动走向终点（方向键或路径变化时停止）
+        const MazePath* shownPath = search.status != SEARCH_IDLE ? &stepPath : (shown != NULL ? &shown->path : NULL);
+        if (IsKeyPressed(KEY_UP) || IsKeyPressed(KEY_DOWN) || IsKeyPressed(KEY_LEFT) || IsKeyPressed(KEY_RIGHT)) following = false;
+        if (IsKeyPressed(KEY_F) && shownPath != NULL && shownPath->length > 0) {
+            MazePathIterBegin(&follow, shownPath);
+            following = true;
+            followTimer = 1.0f / PLAYER_FOLLOW_SPEED;
+        }
+        if (following) {
+            followTimer += GetFrameTime();
+            Point next;
+            while (following && followTimer >= 1.0f / PLAYER_FOLLOW_SPEED) {
+                followTimer -= 1.0f / PLAYER_FOLLOW_SPEED;
+                // 走完或前方格子已被改成墙时停下
+                if (!MazePathIterNext(&follow, &next) || MazeGetCell(maze, next.x, next.y) == CELL_WALL) following = false;
+                else player = next;
             }
-            else {
-                pathLen = 0;
-                TraceLog(LOG_WARNING, "Dijkstra未找到有效路径");
+        }
+
+        // S键：增加一只史莱姆；C键：增加一批
+        if (IsKeyPressed(KEY_S)) SpawnSlimes(maze, player, crowd, stepPd, 1);
+        if (IsKeyPressed(KEY_C)) SpawnSlimes(maze, player, crowd, stepPd, SLIME_SPAWN_BATCH);
+
+        // 史莱姆沿距离场连续向玩家移动：所有史莱姆共用一次反向搜索，每只O(1)查表
+        if (DistanceFieldUpdate(field, maze, player, DEFAULT_TERRAIN_COST)) {
+            CrowdUpdate(crowd, maze, field, GetFrameTime());
+            if (CrowdFindInCell(crowd, maze, player.x, player.y) >= 0) {
+                TraceLog(LOG_INFO, "被史莱姆抓住，回到起点");
+                player = maze->start;
+                following = false;
             }
-            algoType = 3;
         }
 
-        if (IsKeyPressed(KEY_ZERO)) {
-            TraceLog(LOG_INFO, "清空路径");
-            if (pd != NULL) {
-                PathDataDestroy(maze, pd);
-                pd = NULL;
+        // G键：随机生成新迷宫（依次切换生成算法，尺寸与窗口匹配）
+        if (IsKeyPressed(KEY_G)) {
+            MazeGenOptions gen;
+            MazeGenOptionsDefault(&gen, 19, 19, (unsigned long long)GetRandomValue(0, INT_MAX));
+            gen.algorithm = genAlgo;
+            gen.braid = 0.2;
+            gen.grassRatio = 0.08;
+            gen.lavaRatio = 0.02;
+            // 迷宫尺寸可能变化，分步搜索工作区、距离场与地形层随之重建；后台工作区在下次提交时按快照重建
+            MazeAsyncCancel(solver);
+            MazeSearchStop(&search);
+            PathDataDestroy(maze, stepPd);
+            DistanceFieldDestroy(field);
+            TerrainLayerDestroy(terrain);
+            PathLayerDestroy(pathLayer);
+            stepPd = NULL;
+            field = NULL;
+            terrain = NULL;
+            pathLayer = NULL;
+            if (!MazeGenerate(maze, &gen) || (stepPd = PathDataCreate(maze)) == NULL || (field = DistanceFieldCreate(maze)) == NULL ||
+                (terrain = TerrainLayerCreate(maze)) == NULL || (pathLayer = PathLayerCreate(maze)) == NULL) {
+                TraceLog(LOG_ERROR, "迷宫生成失败，程序退出");
+                break;
             }
-            pathLen = 0;
-            algoType = 0;
+            MazeViewInit(&view, maze);
+            player = maze->start;
+            CrowdClear(crowd);
+            SpawnSlimes(maze, player, crowd, stepPd, INITIAL_SLIMES);
+            snprintf(mazeName, sizeof(mazeName), "%s%dx%d", MazeGeneratorName(genAlgo), maze->rows, maze->cols);
+            genAlgo = (MazeGenerator)((genAlgo + 1) % GEN_COUNT);
+            shown = NULL;
+            MazePathClear(&stepPath);
+            following = false;
+            algoType = ALGO_NONE;
         }
 
-        // 渲染逻辑
+        // 渲染逻辑：先把变化的格子重绘进地形层
+        TerrainLayerUpdate(terrain, maze, tex, &view);
         BeginDrawing();
-        ClearBackground(RAYWHITE); // 清空背景
+        ClearBackground(COLOR_BACKGROUND); // 清空背景
 
-        // 绘制纹理版迷宫
-        DrawMazeGridWithTexture(maze, tex);
+        // 迷宫、路径与角色在世界坐标中绘制，由摄像机平移缩放；只绘制可见范围内的内容
+        BeginMode2D(view.camera);
+        DrawTerrainLayer(terrain, maze, &view);
 
-        // 绘制路径（如果有）
-        if (pathLen > 0) {
-            DrawPathOnTexture(maze, path, pathLen);
+        // 绘制分步搜索的进度与路径（如果有）
+        if (search.status != SEARCH_IDLE) {
+            DrawSearchProgress(maze, &view, &search);
+            if (stepPath.length > 0) DrawPathOnTexture(pathLayer, maze, &view, &stepPath);
+        }
+        else if (shown != NULL && shown->path.length > 0) {
+            DrawPathOnTexture(pathLayer, maze, &view, &shown->path);
         }
 
+        // 绘制史莱姆（一个批次）与玩家
+        DrawCrowd(crowd, tex, &view);
+        if (MazeViewCellVisible(&view, player.x, player.y)) DrawSpriteOnCell(maze, tex, TILE_CHARACTER, player.x, player.y);
+        EndMode2D();
+
         // 绘制提示文字
         DrawText("MazeGame", 20, 20, 24, BLACK);
         DrawText("ButtonInstruction-", 20, 60, 20, BLACK);
         DrawText("1 - DFS_path   2 - BFS_path   3 - Dijkstra_path   0 - ClearPath", 20, 90, 20, BLACK);
+        DrawText("4 - Dijkstra(Bucket)_path   5 - Dijkstra(Heap)_path", 20, 115, 20, BLACK);
+        DrawText("6 - AStar_path   7 - JPS_path   8 - BFS(Bits)_path   9 - HPA*_path   D - D*Lite_path", 20, 140, 20, BLACK);
+        DrawText("B - BFS(Bidi)_path   N - Dijkstra(Bidi)_path", 20, 165, 20, BLACK);
+        DrawText(TextFormat("Arrows - MovePlayer   S/C - AddSlime(1/%d)   G - NewMaze   LeftClick - ToggleWall", SLIME_SPAWN_BATCH), 20, 190, 20, BLACK);
+        DrawText(TextFormat("Wheel - Zoom   RightDrag - Pan   V - StepSearch(%s)   F - FollowPath", stepMode ? "On" : "Off"), 20, 215, 20, BLACK);
 
         // 显示当前算法
-        const char* algoName[] = { "NONE", "DFS", "BFS", "Dijkstra" };
-        DrawText(TextFormat("CurrentAlgorithms-%s | PathLength-%d", algoName[algoType], pathLen), 20, 120, 20, RED);
+        if (search.status != SEARCH_IDLE) {
+            const int* frontier = NULL;
+            DrawText(TextFormat("CurrentAlgorithms-%s(Step) | PathLength-%d | Expanded-%d | Frontier-%d%s", MazeAlgorithmName(search.algo), stepPath.length,
+                stepPd->expanded, MazeSearchFrontier(&search, &frontier), search.status == SEARCH_RUNNING ? " | Searching..." : ""), 20, 245, 20, RED);
+        }
+        else {
+            DrawText(TextFormat("CurrentAlgorithms-%s | PathLength-%d | Expanded-%d | Time-%.2fms%s", MazeAlgorithmName(shown != NULL ? shown->algo : ALGO_NONE),
+                shown != NULL ? shown->path.length : 0, shown != NULL ? shown->expanded : 0, shown != NULL ? shown->milliseconds : 0.0,
+                MazeAsyncBusy(solver) ? " | Solving..." : ""), 20, 245, 20, RED);
+        }
+#if MAZE_STATS
+        // 搜索统计（L键追加到日志文件）
+        const SearchStats* stats = search.status != SEARCH_IDLE ? &stepPd->stats : (shown != NULL ? &shown->stats : NULL);
+        if (stats != NULL) {
+            const char* relax = stats->relaxations == STATS_NOT_APPLICABLE ? "n/a" : TextFormat("%lld", stats->relaxations);
+            DrawText(TextFormat("Push-%lld | Pop-%lld | Relax-%s | PeakFrontier-%d | Alloc-%lluB | L - LogStats", stats->pushes, stats->pops,
+                relax, stats->peakFrontier, (unsigned long long)stats->bytesAllocated), 20, 270, 20, RED);
+        }
+#endif
+        DrawText(TextFormat("Slimes-%d | CrowdUpdate-%.2fms | FieldRebuilds-%d | FPS-%d", crowd->count, crowd->milliseconds,
+            field->rebuildCount, GetFPS()), 20, 295, 20, RED);
 
         EndDrawing();
     }
 
     // 释放所有资源
-    if (pd != NULL) PathDataDestroy(maze, pd);
+    MazeAsyncDestroy(solver);
+    if (stepPd != NULL) PathDataDestroy(maze, stepPd);
+    MazePathFree(&stepPath);
+    CrowdDestroy(crowd);
+    DistanceFieldDestroy(field);
+    TerrainLayerDestroy(terrain);
+    PathLayerDestroy(pathLayer);
     MazeDestroy(maze);
     TexturesUnload(tex);
     CloseWindow();
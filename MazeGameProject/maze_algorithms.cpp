@@ -1,65 +1,195 @@
 #include "maze_algorithms.h"
+#include "maze_queue.h"
+#include <string.h>
+#include <chrono>
+
+// ڽӷ0~3Ϊңڽӵĳ˳򣩣4~7Ϊϡϡ¡
+static const int DIR_DX[8] = { 0, 0, -1, 1, -1, 1, -1, 1 };
+static const int DIR_DY[8] = { -1, 1, 0, 0, -1, -1, 1, 1 };
+// бֱˮƽ򣨲ǽʱ߶ͨУ
+static const int DIAG_SIDE_Y[8] = { 0, 0, 0, 0, 0, 0, 1, 1 };
+static const int DIAG_SIDE_X[8] = { 0, 0, 0, 0, 2, 3, 2, 3 };
+
+// ƶʽıڲֱ/бߵĳɱǷǽ
+template <MazeMovement M>
+struct MoveModel {
+    static constexpr int count = M == MOVE_4 ? 4 : 8;
+    static constexpr int straight = M == MOVE_4 ? 1 : MOVE_STRAIGHT_WEIGHT;
+    static constexpr int diagonal = MOVE_DIAGONAL_WEIGHT;
+    static constexpr bool cutCorners = M == MOVE_8_CORNER_CUT;
+
+    // λγɱƵľ½磺ڽΪپ룬˷Ϊ˷
+    static int Distance(int dx, int dy) {
+        dx = abs(dx);
+        dy = abs(dy);
+        if (M == MOVE_4) return dx + dy;
+        int lo = dx < dy ? dx : dy;
+        int hi = dx < dy ? dy : dx;
+        return straight * (hi - lo) + diagonal * lo;
+    }
+};
+
+// γɱģͣFixedCostĳɱǱڳɱ۵TableCost÷ı
+template <const int* Table>
+struct FixedCost {
+    int operator()(int cell) const { return Table[cell - CELL_END]; }
+};
+struct TableCost {
+    const int* table;
+    int operator()(int cell) const { return table[cell - CELL_END]; }
+};
+
+// ں˵ͼھڲǽа̶ƫƷʣԹһȦǽԽж
+typedef struct {
+    const signed char* cells;  // ǽPathData::padGrid
+    int cols;                  // ԭ
+    int stride;                // ǽÿеĸcols + 2
+    int step[8];               // ԭе±
+    int padStep[8];            // ڲǽе±
+} KernelGrid;
+
+static bool KernelGridInit(KernelGrid* g, Maze* maze, PathData* pd) {
+    if (!PathDataReservePadded(pd, maze)) return false;
+    g->cells = pd->padGrid;
+    g->cols = maze->cols;
+    g->stride = maze->cols + 2;
+    for (int d = 0; d < 8; d++) {
+        g->step[d] = DIR_DY[d] * maze->cols + DIR_DX[d];
+        g->padStep[d] = DIR_DY[d] * g->stride + DIR_DX[d];
+    }
+    return true;
+}
+
+// ԭ±תǽ±꣺(y+1)*(cols+2) + (x+1)
+static inline int KernelPad(const KernelGrid* g, int u) {
+    return u + 2 * (u / g->cols) + g->stride + 1;
+}
+
+// ܷӲǽ±puطdһĿ겻ǽǽʱбҲǽ
+template <MazeMovement M>
+static inline bool KernelCanStep(const KernelGrid* g, int pu, int d) {
+    if (g->cells[pu + g->padStep[d]] == CELL_WALL) return false;
+    if (MoveModel<M>::count == 4 || MoveModel<M>::cutCorners || d < 4) return true;
+    return g->cells[pu + g->padStep[DIAG_SIDE_Y[d]]] != CELL_WALL && g->cells[pu + g->padStep[DIAG_SIDE_X[d]]] != CELL_WALL;
+}
+
+// طdΪcellĸӵĳɱͨʱΪCOST_IMPASSABLE
+template <MazeMovement M, class Cost>
+static inline int KernelStepCost(const Cost& cost, int cell, int d) {
+    int c = cost(cell);
+    if (c == COST_IMPASSABLE) return COST_IMPASSABLE;
+    return c * (d < 4 ? MoveModel<M>::straight : MoveModel<M>::diagonal);
+}
+
+// ɱпͨеεС󵥲ɱѳԶӦƶ
+template <MazeMovement M, class Cost>
+static void KernelCostRange(const Cost& cost, int* minCost, int* maxCost) {
+    *minCost = INT_MAX;
+    *maxCost = 1;
+    for (int t = 0; t < CELL_TYPE_COUNT; t++) {
+        int c = cost(t + CELL_END);
+        if (c == COST_IMPASSABLE) continue;
+        if (c < *minCost) *minCost = c;
+        if (c > *maxCost) *maxCost = c;
+    }
+    if (*minCost == INT_MAX) *minCost = 0;
+    int widest = MoveModel<M>::count == 4 ? MoveModel<M>::straight : MoveModel<M>::diagonal;
+    *maxCost *= widest;
+}
+
+template <MazeMovement M>
+static bool DfsKernel(Maze* maze, PathData* pd, int x, int y) {
+    PathDataReset(pd);
 
-bool DFS(Maze* maze, PathData* pd, int x, int y) {
     // ֹյ
     if (x == maze->end.x && y == maze->end.y) return true;
-    // ֹЧ/ѷ/ǽ
-    if (!IsPointValid(maze, x, y) || pd->visited[y][x] || maze->grid[y][x] == CELL_WALL) return false;
+    // ֹЧ/ǽ
+    if (!IsPointValid(maze, x, y) || MazeGetCell(maze, x, y) == CELL_WALL) return false;
+
+    // ʽջݹ飨ÿջһΣʹùԤջⳤԹջ
+    KernelGrid g;
+    if (!PathDataReserveQueue(pd) || !KernelGridInit(&g, maze, pd)) return false;
+    int* stack = pd->queue;
+    unsigned char* nextDir = pd->dirStack;
 
     // Ϊѷ
-    pd->visited[y][x] = true;
-
-    // ĸң
-    int dx[] = { 0, 0, -1, 1 };
-    int dy[] = { -1, 1, 0, 0 };
-    for (int i = 0; i < 4; i++) {
-        int nx = x + dx[i];
-        int ny = y + dy[i];
-        if (DFS(maze, pd, nx, ny)) {
-            // ¼ڵ
-            pd->parent[ny][nx].x = x;
-            pd->parent[ny][nx].y = y;
+    int top = 0;
+    stack[0] = MazeIndex(maze, x, y);
+    nextDir[0] = 0;
+    PathDataSet(pd, stack[0], 0, -1);
+    PathDataStatPush(pd, 1);
+    pd->expanded++;
+
+    // γԣڽʱΪңݹĳ˳һ£
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    while (top >= 0) {
+        if (nextDir[top] == MoveModel<M>::count) {
+            PathDataStatPop(pd);
+            top--; // зѳԣ
+            continue;
+        }
+        int u = stack[top];
+        int dir = nextDir[top]++;
+        if (!KernelCanStep<M>(&g, KernelPad(&g, u), dir)) continue;
+        int v = u + g.step[dir];
+        PathDataStatRelax(pd);
+
+        if (v == endIndex) {
+            PathDataSet(pd, v, pd->distance[u] + 1, u);
             return true;
         }
+        if (PathDataSeen(pd, v)) continue;
+
+        // ̽ʱ¼ڵ㣨·ϵĸڵ㲻ջУ
+        PathDataSet(pd, v, pd->distance[u] + 1, u);
+        pd->expanded++;
+        if (PathDataCancelled(pd)) return false;
+        top++;
+        stack[top] = v;
+        nextDir[top] = 0;
+        PathDataStatPush(pd, top + 1);
     }
 
     return false;
 }
 
-bool BFS(Maze* maze, PathData* pd) {
-    // ʼУ20x20Թ400ڵ㣩
-    Point queue[400];
+template <MazeMovement M>
+static bool BfsKernel(Maze* maze, PathData* pd) {
+    PathDataReset(pd);
+
+    // ʹùԤĻÿһΣ
+    KernelGrid g;
+    if (!PathDataReserveQueue(pd) || !KernelGridInit(&g, maze, pd)) return false;
+    int* queue = pd->queue;
     int front = 0, rear = 0;
 
     // ӣΪѷ
-    queue[rear++] = maze->start;
-    pd->visited[maze->start.y][maze->start.x] = true;
-
-    // ĸ
-    int dx[] = { 0, 0, -1, 1 };
-    int dy[] = { -1, 1, 0, 0 };
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    queue[rear++] = startIndex;
+    PathDataSet(pd, startIndex, 0, -1);
+    PathDataStatPush(pd, 1);
 
     while (front < rear) {
-        Point curr = queue[front++];
+        int u = queue[front++];
+        PathDataStatPop(pd);
+        pd->expanded++;
+        if (PathDataCancelled(pd)) return false;
 
         // յ
-        if (curr.x == maze->end.x && curr.y == maze->end.y) return true;
-
-        // ĸ
-        for (int i = 0; i < 4; i++) {
-            int nx = curr.x + dx[i];
-            int ny = curr.y + dy[i];
-            if (IsPointValid(maze, nx, ny) && !pd->visited[ny][nx] && maze->grid[ny][nx] != CELL_WALL) {
-                pd->visited[ny][nx] = true;
-                pd->parent[ny][nx] = curr; // ¼ڵ
-                Point temp = { nx, ny };
-                queue[rear++] = temp;
+        if (u == endIndex) return true;
 
-                // ֹ
-                if (rear >= 400) {
-                    TraceLog(LOG_WARNING, "BFS");
-                    break;
-                }
+        // 
+        int pu = KernelPad(&g, u);
+        int du = pd->distance[u];
+        for (int i = 0; i < MoveModel<M>::count; i++) {
+            if (!KernelCanStep<M>(&g, pu, i)) continue;
+            int v = u + g.step[i];
+            PathDataStatRelax(pd);
+            if (!PathDataSeen(pd, v)) {
+                PathDataSet(pd, v, du + 1, u); // ¼ڵ
+                queue[rear++] = v;
+                PathDataStatPush(pd, rear - front);
             }
         }
     }
@@ -67,58 +197,68 @@ bool BFS(Maze* maze, PathData* pd) {
     return false; // ·
 }
 
-bool Dijkstra(Maze* maze, PathData* pd) {
+template <MazeMovement M, class Cost>
+static bool DijkstraScanKernel(Maze* maze, PathData* pd, const Cost& cost) {
+    PathDataReset(pd);
+    KernelGrid g;
+    if (!KernelGridInit(&g, maze, pd)) return false;
+
     // Ϊ0
-    pd->distance[maze->start.y][maze->start.x] = 0;
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    PathDataSet(pd, startIndex, 0, -1);
+    int open = 1; // ѷδȷĸֻͳǰشС
+    PathDataStatPush(pd, open);
 
     // нڵ
-    for (int count = 0; count < maze->rows * maze->cols - 1; count++) {
-        // ҵδʵľСĽڵ
+    int total = maze->rows * maze->cols;
+    for (int count = 0; count < total - 1; count++) {
+        // ҵδȷľСĽڵ
         int minDist = INT_MAX;
-        Point u = { -1, -1 };
-        for (int y = 0; y < maze->rows; y++) {
-            for (int x = 0; x < maze->cols; x++) {
-                if (!pd->visited[y][x] && pd->distance[y][x] <= minDist) {
-                    minDist = pd->distance[y][x];
-                    u.x = x;
-                    u.y = y;
-                }
+        int u = -1;
+        for (int i = 0; i < total; i++) {
+            int d = PathDataDistance(pd, i);
+            if (d != INT_MAX && d <= minDist && !PathDataClosed(pd, i)) {
+                minDist = d;
+                u = i;
             }
         }
 
-        // нڵѴ޿ɴڵ
-        if (u.x == -1) break;
+        // пɴڵѴ
+        if (u == -1) break;
 
-        // Ϊѷ
-        pd->visited[u.y][u.x] = true;
+        // Ϊȷ
+        PathDataClose(pd, u);
+        PathDataStatPop(pd);
+        open--;
+        pd->expanded++;
+        if (PathDataCancelled(pd)) return false;
 
         // յǰ˳
-        if (u.x == maze->end.x && u.y == maze->end.y) break;
+        if (u == endIndex) break;
 
-        // ڽӽڵľ
-        int dx[] = { 0, 0, -1, 1 };
-        int dy[] = { -1, 1, 0, 0 };
-        for (int i = 0; i < 4; i++) {
-            int nx = u.x + dx[i];
-            int ny = u.y + dy[i];
-            if (IsPointValid(maze, nx, ny) && !pd->visited[ny][nx] && maze->grid[ny][nx] != CELL_WALL) {
-                // 棺ͨɱ1ݵ/ݰ1׿޸ģ
-                int cost = 1;
-                if (maze->grid[ny][nx] == CELL_GRASS) cost = 3;
-                if (maze->grid[ny][nx] == CELL_LAVA) cost = 1000;
+        // ڽӽڵľ루ɱɳɱģ͸
+        int pu = KernelPad(&g, u);
+        for (int i = 0; i < MoveModel<M>::count; i++) {
+            if (!KernelCanStep<M>(&g, pu, i)) continue;
+            int v = u + g.step[i];
+            PathDataStatRelax(pd);
+            if (PathDataClosed(pd, v)) continue;
+            int step = KernelStepCost<M>(cost, g.cells[pu + g.padStep[i]], i);
+            if (step == COST_IMPASSABLE) continue;
 
-                if (pd->distance[u.y][u.x] != INT_MAX && pd->distance[u.y][u.x] + cost < pd->distance[ny][nx]) {
-                    pd->distance[ny][nx] = pd->distance[u.y][u.x] + cost;
-                    pd->parent[ny][nx] = u; // ¼ڵ
-                }
+            if (minDist + step < PathDataDistance(pd, v)) {
+                if (!PathDataSeen(pd, v)) open++;
+                PathDataSet(pd, v, minDist + step, u); // ¼ڵ
+                PathDataStatPush(pd, open);
             }
         }
     }
 
     // յǷɴ
-    bool reachable = (pd->distance[maze->end.y][maze->end.x] != INT_MAX);
+    bool reachable = (PathDataDistance(pd, endIndex) != INT_MAX);
     if (reachable) {
-        TraceLog(LOG_INFO, "Dijkstra·ɱ%d", pd->distance[maze->end.y][maze->end.x]);
+        TraceLog(LOG_INFO, "Dijkstra·ɱ%d", pd->distance[endIndex]);
     }
     else {
         TraceLog(LOG_WARNING, "Dijkstra㷨δҵɴ·");
@@ -126,4 +266,656 @@ bool Dijkstra(Maze* maze, PathData* pd) {
     return reachable;
 }
 
+// ȶеDijkstrauseBucketsΪtrueʱͰУDial
+template <MazeMovement M, class Cost>
+static bool DijkstraQueuedKernel(Maze* maze, PathData* pd, const Cost& cost, bool useBuckets, const char* name) {
+    PathDataReset(pd);
+    KernelGrid g;
+    if (!KernelGridInit(&g, maze, pd)) return false;
+
+    // Ͱ󵥲۾
+    int minCost, maxCost;
+    KernelCostRange<M>(cost, &minCost, &maxCost);
+
+    // ȡԹ
+    BucketQueue* bq = NULL;
+    IndexedHeap* hq = NULL;
+    if (useBuckets) bq = PathDataBuckets(pd, maxCost);
+    else hq = PathDataHeap(pd);
+    if (bq == NULL && hq == NULL) return false;
+
+    // ӣΪ0
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    PathDataSet(pd, startIndex, 0, -1);
+    if (useBuckets) BucketQueuePush(bq, startIndex, 0);
+    else IndexedHeapPush(hq, startIndex, 0);
+    PathDataStatPush(pd, 1);
+
+    bool reachable = false;
+    while (useBuckets ? bq->size > 0 : hq->size > 0) {
+        // ȡСĽڵ㲢Ϊȷ
+        int u = useBuckets ? BucketQueuePop(bq) : IndexedHeapPop(hq);
+        PathDataClose(pd, u);
+        PathDataStatPop(pd);
+        pd->expanded++;
+        if (PathDataCancelled(pd)) return false;
+
+        // յ㼴˳ʱ̣
+        if (u == endIndex) {
+            reachable = true;
+            break;
+        }
+
+        int pu = KernelPad(&g, u);
+        int du = pd->distance[u];
+        for (int i = 0; i < MoveModel<M>::count; i++) {
+            if (!KernelCanStep<M>(&g, pu, i)) continue;
+            int v = u + g.step[i];
+            PathDataStatRelax(pd);
+            if (PathDataClosed(pd, v)) continue;
+            int step = KernelStepCost<M>(cost, g.cells[pu + g.padStep[i]], i);
+            if (step == COST_IMPASSABLE) continue;
+
+            int nd = du + step;
+            if (nd < PathDataDistance(pd, v)) {
+                PathDataSet(pd, v, nd, u); // ¼ڵ
+                if (useBuckets) BucketQueuePush(bq, v, nd);
+                else IndexedHeapPush(hq, v, nd);
+                PathDataStatPush(pd, useBuckets ? bq->size : hq->size);
+            }
+        }
+    }
+
+    if (reachable) {
+        TraceLog(LOG_INFO, "%s·ɱ%d", name, pd->distance[endIndex]);
+    }
+    else {
+        TraceLog(LOG_WARNING, "%s㷨δҵɴ·", name);
+    }
+    return reachable;
+}
+
+// жϸǷͨУԽΪͨУ
+static bool IsPassable(Maze* maze, int x, int y) {
+    return IsPointValid(maze, x, y) && MazeGetCell(maze, x, y) != CELL_WALL;
+}
+
+// A*ĶѼֵfСȣfͬʱgȣյ㣩
+static long long AStarKey(int f, int g) {
+    return ((long long)f << 31) | (long long)(INT_MAX - g);
+}
+
+template <MazeMovement M, class Cost>
+static bool AStarKernel(Maze* maze, PathData* pd, const Cost& cost) {
+    PathDataReset(pd);
+    KernelGrid g;
+    if (!KernelGridInit(&g, maze, pd)) return false;
+
+    // ½磨ٻ˷룩Сγɱ֤߹
+    int minCost, maxCost;
+    KernelCostRange<M>(cost, &minCost, &maxCost);
+
+    IndexedHeap* open = PathDataHeap(pd);
+    if (open == NULL) return false;
+
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    PathDataSet(pd, startIndex, 0, -1);
+    int h0 = MoveModel<M>::Distance(maze->start.x - maze->end.x, maze->start.y - maze->end.y) * minCost;
+    IndexedHeapPush(open, startIndex, AStarKey(h0, 0));
+    PathDataStatPush(pd, 1);
+
+    bool reachable = false;
+    while (open->size > 0) {
+        int u = IndexedHeapPop(open);
+        PathDataClose(pd, u);
+        PathDataStatPop(pd);
+        pd->expanded++;
+        if (PathDataCancelled(pd)) return false;
+
+        if (u == endIndex) {
+            reachable = true;
+            break;
+        }
+
+        int ux = u % maze->cols;
+        int uy = u / maze->cols;
+        int pu = u + 2 * uy + g.stride + 1;
+        int gu = pd->distance[u];
+        for (int i = 0; i < MoveModel<M>::count; i++) {
+            if (!KernelCanStep<M>(&g, pu, i)) continue;
+            int v = u + g.step[i];
+            PathDataStatRelax(pd);
+            if (PathDataClosed(pd, v)) continue;
+            int step = KernelStepCost<M>(cost, g.cells[pu + g.padStep[i]], i);
+            if (step == COST_IMPASSABLE) continue;
+
+            int gv = gu + step;
+            if (gv < PathDataDistance(pd, v)) {
+                PathDataSet(pd, v, gv, u); // ¼ڵ
+                int h = MoveModel<M>::Distance(ux + DIR_DX[i] - maze->end.x, uy + DIR_DY[i] - maze->end.y) * minCost;
+                IndexedHeapPush(open, v, AStarKey(gv + h, gv));
+                PathDataStatPush(pd, open->size);
+            }
+        }
+    }
+
+    if (reachable) {
+        TraceLog(LOG_INFO, "A*·ɱ%dչڵ%d", pd->distance[endIndex], pd->expanded);
+    }
+    else {
+        TraceLog(LOG_WARNING, "A*㷨δҵɴ·");
+    }
+    return reachable;
+}
+
+// ɱĬϱͬʱʹñڳɱػںˣ뵥ԪһĬϱݱȽϣ
+static bool IsDefaultCostTable(const int* costTable) {
+    return costTable == DEFAULT_TERRAIN_COST || memcmp(costTable, DEFAULT_TERRAIN_COST, sizeof(DEFAULT_TERRAIN_COST)) == 0;
+}
+
+// 㷨ɵĳһƶʽɱģػں
+template <MazeMovement M, class Cost>
+static bool KernelSolve(Maze* maze, PathData* pd, MazeAlgorithm algo, const Cost& cost) {
+    switch (algo) {
+    case ALGO_DIJKSTRA:        return DijkstraScanKernel<M>(maze, pd, cost);
+    case ALGO_DIJKSTRA_BUCKET: return DijkstraQueuedKernel<M>(maze, pd, cost, true, "Dijkstra(Bucket)");
+    case ALGO_DIJKSTRA_HEAP:   return DijkstraQueuedKernel<M>(maze, pd, cost, false, "Dijkstra(Heap)");
+    case ALGO_ASTAR:           return AStarKernel<M>(maze, pd, cost);
+    default:                   return false;
+    }
+}
+
+template <MazeMovement M>
+static bool KernelSolve(Maze* maze, PathData* pd, MazeAlgorithm algo, const int* costTable) {
+    // DFS/BFSֻǽǽɱػ
+    if (algo == ALGO_DFS) return DfsKernel<M>(maze, pd, maze->start.x, maze->start.y);
+    if (algo == ALGO_BFS) return BfsKernel<M>(maze, pd);
+    if (IsDefaultCostTable(costTable)) return KernelSolve<M>(maze, pd, algo, FixedCost<DEFAULT_TERRAIN_COST>());
+    return KernelSolve<M>(maze, pd, algo, TableCost{ costTable });
+}
+
+bool DFS(Maze* maze, PathData* pd, int x, int y) {
+    return DfsKernel<MOVE_4>(maze, pd, x, y);
+}
+
+bool BFS(Maze* maze, PathData* pd) {
+    return BfsKernel<MOVE_4>(maze, pd);
+}
+
+bool Dijkstra(Maze* maze, PathData* pd) {
+    return DijkstraScanKernel<MOVE_4>(maze, pd, FixedCost<DEFAULT_TERRAIN_COST>());
+}
+
+bool DijkstraBucket(Maze* maze, PathData* pd, const int* costTable) {
+    return KernelSolve<MOVE_4>(maze, pd, ALGO_DIJKSTRA_BUCKET, costTable);
+}
+
+bool DijkstraHeap(Maze* maze, PathData* pd, const int* costTable) {
+    return KernelSolve<MOVE_4>(maze, pd, ALGO_DIJKSTRA_HEAP, costTable);
+}
+
+bool AStar(Maze* maze, PathData* pd, const int* costTable) {
+    return KernelSolve<MOVE_4>(maze, pd, ALGO_ASTAR, costTable);
+}
+
+// JPSԾ(x,y)(dx,dy)ֱǰ±꣨㷵-1
+// 4ڽӹˮƽƶ·ǿھӣֱƶܷ
+static int JpsJump(Maze* maze, int x, int y, int dx, int dy) {
+    for (;;) {
+        if (!IsPassable(maze, x, y)) return -1;
+        if (x == maze->end.x && y == maze->end.y) return MazeIndex(maze, x, y);
+
+        if (dx != 0) {
+            if ((IsPassable(maze, x, y - 1) && !IsPassable(maze, x - dx, y - 1)) ||
+                (IsPassable(maze, x, y + 1) && !IsPassable(maze, x - dx, y + 1))) {
+                return MazeIndex(maze, x, y);
+            }
+        }
+        else {
+            if ((IsPassable(maze, x - 1, y) && !IsPassable(maze, x - 1, y - dy)) ||
+                (IsPassable(maze, x + 1, y) && !IsPassable(maze, x + 1, y - dy))) {
+                return MazeIndex(maze, x, y);
+            }
+            if (JpsJump(maze, x + 1, y, 1, 0) != -1 || JpsJump(maze, x - 1, y, -1, 0) != -1) {
+                return MazeIndex(maze, x, y);
+            }
+        }
+        x += dx;
+        y += dy;
+    }
+}
+
+bool JumpPointSearch(Maze* maze, PathData* pd) {
+    PathDataReset(pd);
+
+    IndexedHeap* open = PathDataHeap(pd);
+    if (open == NULL) return false;
+
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    PathDataSet(pd, startIndex, 0, -1);
+    int h0 = abs(maze->start.x - maze->end.x) + abs(maze->start.y - maze->end.y);
+    IndexedHeapPush(open, startIndex, AStarKey(h0, 0));
+    PathDataStatPush(pd, 1);
+
+    bool reachable = false;
+    while (open->size > 0) {
+        int u = IndexedHeapPop(open);
+        PathDataClose(pd, u);
+        PathDataStatPop(pd);
+        pd->expanded++;
+        if (PathDataCancelled(pd)) return false;
+
+        if (u == endIndex) {
+            reachable = true;
+            break;
+        }
+
+        // ݵ﷽üھӣˮƽʱǰ£ֱʱǰңȫ
+        int ux = u % maze->cols;
+        int uy = u / maze->cols;
+        int dirX[4] = { 0, 0, -1, 1 };
+        int dirY[4] = { -1, 1, 0, 0 };
+        int dirCount = 4;
+        int p = pd->parent[u];
+        if (p != -1) {
+            Point pp = MazePointFromIndex(maze, p);
+            int px = (ux > pp.x) - (ux < pp.x);
+            int py = (uy > pp.y) - (uy < pp.y);
+            if (px != 0) {
+                dirX[2] = px; dirY[2] = 0; // ϡ¡ǰ
+            }
+            else {
+                dirX[0] = 0; dirY[0] = py; // ǰ
+                dirX[1] = -1; dirY[1] = 0;
+                dirX[2] = 1; dirY[2] = 0;
+            }
+            dirCount = 3;
+        }
+
+        int gu = pd->distance[u];
+        for (int i = 0; i < dirCount; i++) {
+            int j = JpsJump(maze, ux + dirX[i], uy + dirY[i], dirX[i], dirY[i]);
+            PathDataStatRelax(pd);
+            if (j == -1 || PathDataClosed(pd, j)) continue;
+            int jx = j % maze->cols;
+            int jy = j / maze->cols;
+
+            int g = gu + abs(jx - ux) + abs(jy - uy);
+            if (g < PathDataDistance(pd, j)) {
+                PathDataSet(pd, j, g, u); // ¼㸸ڵ
+                int h = abs(jx - maze->end.x) + abs(jy - maze->end.y);
+                IndexedHeapPush(open, j, AStarKey(g + h, g));
+                PathDataStatPush(pd, open->size);
+            }
+        }
+    }
+
+    if (!reachable) {
+        TraceLog(LOG_WARNING, "JPS㷨δҵɴ·");
+        return false;
+    }
+
+    // ֱ֮߶βΪĸڵPathBacktrack
+    int cur = endIndex;
+    while (cur != startIndex) {
+        int jumpParent = pd->parent[cur];
+        Point a = MazePointFromIndex(maze, cur);
+        Point b = MazePointFromIndex(maze, jumpParent);
+        int step = ((b.x > a.x) - (b.x < a.x)) + ((b.y > a.y) - (b.y < a.y)) * maze->cols;
+        int dist = pd->distance[cur];
+        for (int c = cur; c != jumpParent; c += step) {
+            PathDataSet(pd, c, dist--, c + step);
+        }
+        cur = jumpParent;
+    }
+
+    TraceLog(LOG_INFO, "JPS·ȣ%dչڵ%d", pd->distance[endIndex], pd->expanded);
+    return true;
+}
+
+bool BitParallelBFS(Maze* maze, PathData* pd) {
+    PathDataReset(pd);
+    if (!PathDataReserveBits(pd, maze) || !PathDataReserveQueue(pd)) return false;
+
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    int steps = BitBfsSearch(pd->bitGrid, pd->bitWork, startIndex, endIndex);
+    pd->expanded = pd->bitWork->visitedCount;
+    PathDataStatCopy(pd, &pd->bitWork->stats);
+    if (steps < 0) {
+        TraceLog(LOG_WARNING, "BFS(Bits)㷨δҵɴ·");
+        return false;
+    }
+
+    // ֻΪ·ϵĸӼ¼ڵ㣬PathBacktrack
+    int* cells = pd->queue;
+    int len = BitBfsTrace(pd->bitGrid, pd->bitWork, endIndex, cells, pd->cellCount);
+    for (int i = 0; i < len; i++) {
+        PathDataSet(pd, cells[i], i, i > 0 ? cells[i - 1] : -1);
+    }
 
+    TraceLog(LOG_INFO, "BFS(Bits)·ȣ%dʸ%d", steps, pd->expanded);
+    return len > 0;
+}
+
+bool HierarchicalAStar(Maze* maze, PathData* pd) {
+    PathDataReset(pd);
+    if (!PathDataReserveHpa(pd, maze) || !PathDataReserveQueue(pd)) return false;
+
+    int* cells = pd->queue;
+    int len = HpaFindPath(pd->hpa, pd->hpaSearch, maze, maze->start, maze->end, cells, pd->cellCount);
+    pd->expanded = pd->hpaSearch->expanded;
+    PathDataStatCopy(pd, &pd->hpaSearch->stats);
+    if (len == 0) {
+        TraceLog(LOG_WARNING, "HPA*㷨δҵɴ·");
+        return false;
+    }
+
+    // Ϊ·ϵĸӼ¼ڵ㣻ϸƴӴ۷·ϵĸʱɾȥмĻ
+    int count = 0;
+    for (int i = 0; i < len; i++) {
+        int cell = cells[i];
+        if (PathDataSeen(pd, cell)) {
+            int keep = pd->distance[cell] + 1;
+            while (count > keep) {
+                count--;
+                PathDataForget(pd, cells[count]);
+            }
+            continue;
+        }
+        PathDataSet(pd, cell, count, count > 0 ? cells[count - 1] : -1);
+        cells[count++] = cell;
+    }
+
+    TraceLog(LOG_INFO, "HPA*·ȣ%dչڵ%d", count, pd->expanded);
+    return true;
+}
+
+bool DStarLiteSolve(Maze* maze, PathData* pd) {
+    PathDataReset(pd);
+    if (!PathDataReserveDStar(pd, maze) || !PathDataReserveQueue(pd)) return false;
+
+    // յ仯ʱ³ʼյ㲻ʱֻƶ㣬ϴε״̬
+    DStarLite* d = pd->dstar;
+    if (d->goal != MazeIndex(maze, maze->end.x, maze->end.y)) DStarReset(d, maze->start, maze->end);
+    else DStarSetStart(d, maze->start);
+    bool found = DStarPlan(d, maze);
+    pd->expanded = d->expanded;
+    PathDataStatCopy(pd, &d->stats);
+    if (!found) {
+        TraceLog(LOG_WARNING, "D*Lite㷨δҵɴ·");
+        return false;
+    }
+
+    int* cells = pd->queue;
+    // Ȩ㷨һ£distance¼㵽øĳɱgΪյĳɱ·ݼ
+    int len = DStarPath(d, maze, cells, pd->cellCount);
+    for (int i = 0; i < len; i++) {
+        PathDataSet(pd, cells[i], d->g[d->start] - d->g[cells[i]], i > 0 ? cells[i - 1] : -1);
+    }
+
+    TraceLog(LOG_INFO, "D*Lite·ɱ%dδ%d", d->g[d->start], pd->expanded);
+    return len > 0;
+}
+
+// ˫BFSչһһ㣺forwardΪtrueʱһչյһ෴չ
+// ·ֵĸѱһ෢֣ಽ֮͸
+static void BidiBfsExpandLevel(const KernelGrid* g, PathData* pd, bool forward, int* queue, int* front, int* rear, int* best, int* meet) {
+    int levelEnd = *rear;
+    while (*front < levelEnd) {
+        int u = queue[(*front)++];
+        PathDataStatPop(pd);
+        pd->expanded++;
+        if (PathDataCancelled(pd)) return;
+
+        int pu = KernelPad(g, u);
+        int du = forward ? pd->distance[u] : pd->backDistance[u];
+        for (int i = 0; i < 4; i++) {
+            if (!KernelCanStep<MOVE_4>(g, pu, i)) continue;
+            int v = u + g->step[i];
+            PathDataStatRelax(pd);
+            if (forward ? PathDataSeen(pd, v) : PathDataBackSeen(pd, v)) continue;
+
+            if (forward) PathDataSet(pd, v, du + 1, u);
+            else PathDataBackSet(pd, v, du + 1, u);
+            queue[(*rear)++] = v;
+            PathDataStatPush(pd, *rear - *front);
+
+            int other = forward ? PathDataBackDistance(pd, v) : PathDataDistance(pd, v);
+            if (other != INT_MAX && du + 1 + other < *best) {
+                *best = du + 1 + other;
+                *meet = v;
+            }
+        }
+    }
+}
+
+bool BidirectionalBFS(Maze* maze, PathData* pd) {
+    PathDataReset(pd);
+    KernelGrid g;
+    if (!PathDataReserveQueue(pd) || !PathDataReserveBackward(pd, true, false) || !KernelGridInit(&g, maze, pd)) return false;
+
+    // һУÿÿһΣ
+    int* fq = pd->queue;
+    int* bq = pd->backQueue;
+    int fFront = 0, fRear = 0, bFront = 0, bRear = 0;
+
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    PathDataSet(pd, startIndex, 0, -1);
+    PathDataBackSet(pd, endIndex, 0, -1);
+    fq[fRear++] = startIndex;
+    bq[bRear++] = endIndex;
+    PathDataStatPush(pd, 1);
+    PathDataStatPush(pd, 1);
+
+    int best = INT_MAX;
+    int meet = -1;
+    if (startIndex == endIndex) {
+        best = 0;
+        meet = startIndex;
+    }
+
+    // ÿչǰؽСһһ㣻ڷֹͣȡ̵
+    while (meet == -1 && fFront < fRear && bFront < bRear && !PathDataCancelled(pd)) {
+        if (fRear - fFront <= bRear - bFront) BidiBfsExpandLevel(&g, pd, true, fq, &fFront, &fRear, &best, &meet);
+        else BidiBfsExpandLevel(&g, pd, false, bq, &bFront, &bRear, &best, &meet);
+    }
+    if (PathDataCancelled(pd)) return false;
+
+    if (meet == -1) {
+        TraceLog(LOG_WARNING, "BFS(Bidi)㷨δҵɴ·");
+        return false;
+    }
+
+    PathDataJoin(pd, maze, meet, NULL);
+    TraceLog(LOG_INFO, "BFS(Bidi)·ȣ%dչڵ%d", best, pd->expanded);
+    return true;
+}
+
+bool BidirectionalDijkstra(Maze* maze, PathData* pd, const int* costTable) {
+    PathDataReset(pd);
+
+    // ùѣ÷
+    KernelGrid g;
+    IndexedHeap* fh = PathDataHeap(pd);
+    if (fh == NULL || !PathDataReserveBackward(pd, false, true) || !KernelGridInit(&g, maze, pd)) return false;
+    IndexedHeap* bh = pd->backHeap;
+
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    PathDataSet(pd, startIndex, 0, -1);
+    PathDataBackSet(pd, endIndex, 0, -1);
+    IndexedHeapPush(fh, startIndex, 0);
+    IndexedHeapPush(bh, endIndex, 0);
+    PathDataStatPush(pd, 1);
+    PathDataStatPush(pd, 2);
+
+    // bestΪĿǰֵյɱmumeetΪӦ
+    int best = INT_MAX;
+    int meet = -1;
+    if (startIndex == endIndex) {
+        best = 0;
+        meet = startIndex;
+    }
+
+    while (fh->size > 0 && bh->size > 0) {
+        // ֹͣѶ֮ͲСbestʱκδֵ·
+        long long topSum = fh->key[fh->heap[0]] + bh->key[bh->heap[0]];
+        if (topSum >= best) break;
+
+        // չÿȡԪؽٵһ
+        bool forward = fh->size <= bh->size;
+        int u = forward ? IndexedHeapPop(fh) : IndexedHeapPop(bh);
+        if (forward) PathDataClose(pd, u);
+        else PathDataBackClose(pd, u);
+        PathDataStatPop(pd);
+        pd->expanded++;
+        if (PathDataCancelled(pd)) return false;
+
+        int pu = KernelPad(&g, u);
+        int du = forward ? pd->distance[u] : pd->backDistance[u];
+        // u->vĳɱǽvĳɱv->uĳɱǽuĳɱھͬ
+        int costU = forward ? 0 : TerrainCost(costTable, (CellType)g.cells[pu]);
+        for (int i = 0; i < 4; i++) {
+            if (!KernelCanStep<MOVE_4>(&g, pu, i)) continue;
+            int v = u + g.step[i];
+            PathDataStatRelax(pd);
+            if (forward ? PathDataClosed(pd, v) : PathDataBackClosed(pd, v)) continue;
+            int costV = TerrainCost(costTable, (CellType)g.cells[pu + g.padStep[i]]);
+            if (costV == COST_IMPASSABLE) continue;
+
+            int nd = du + (forward ? costV : costU);
+            if (forward) {
+                if (nd >= PathDataDistance(pd, v)) continue;
+                PathDataSet(pd, v, nd, u); // ¼ڵ
+                IndexedHeapPush(fh, v, nd);
+                PathDataStatPush(pd, fh->size + bh->size);
+            }
+            else {
+                if (nd >= PathDataBackDistance(pd, v)) continue;
+                PathDataBackSet(pd, v, nd, u); // ¼
+                IndexedHeapPush(bh, v, nd);
+                PathDataStatPush(pd, fh->size + bh->size);
+            }
+
+            // ඼ѷvvյ·ɱΪ֮
+            int other = forward ? PathDataBackDistance(pd, v) : PathDataDistance(pd, v);
+            if (other != INT_MAX && nd + other < best) {
+                best = nd + other;
+                meet = v;
+            }
+        }
+    }
+
+    if (meet == -1) {
+        TraceLog(LOG_WARNING, "Dijkstra(Bidi)㷨δҵɴ·");
+        return false;
+    }
+
+    PathDataJoin(pd, maze, meet, costTable);
+    TraceLog(LOG_INFO, "Dijkstra(Bidi)·ɱ%dչڵ%d", best, pd->expanded);
+    return true;
+}
+
+const char* MazeAlgorithmName(MazeAlgorithm algo) {
+    static const char* names[ALGO_COUNT] = { "NONE", "DFS", "BFS", "Dijkstra", "Dijkstra(Bucket)", "Dijkstra(Heap)", "A*", "JPS", "BFS(Bits)", "HPA*", "D*Lite", "BFS(Bidi)", "Dijkstra(Bidi)" };
+    if (algo < 0 || algo >= ALGO_COUNT) return "UNKNOWN";
+    return names[algo];
+}
+
+const char* MazeMovementName(MazeMovement movement) {
+    static const char* names[MOVE_COUNT] = { "4", "8", "8cut" };
+    if (movement < 0 || movement >= MOVE_COUNT) return "UNKNOWN";
+    return names[movement];
+}
+
+bool MazeAlgorithmSupports(MazeAlgorithm algo, MazeMovement movement) {
+    if (algo <= ALGO_NONE || algo >= ALGO_COUNT || movement < 0 || movement >= MOVE_COUNT) return false;
+    if (movement == MOVE_4) return true;
+    return algo == ALGO_DFS || algo == ALGO_BFS || algo == ALGO_DIJKSTRA || algo == ALGO_DIJKSTRA_BUCKET ||
+        algo == ALGO_DIJKSTRA_HEAP || algo == ALGO_ASTAR;
+}
+
+bool MazeEndpointsConnected(Maze* maze, PathData* pd) {
+    if (!IsPointValid(maze, maze->start.x, maze->start.y) || !IsPointValid(maze, maze->end.x, maze->end.y)) return true;
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    if (maze->grid[startIndex] == CELL_WALL || maze->grid[endIndex] == CELL_WALL) return true;
+    const ComponentIndex* ci = PathDataReserveComponents(pd, maze);
+    return ci == NULL || ComponentIndexConnected(ci, maze, startIndex, endIndex);
+}
+
+// ŷɵ㷨
+static bool MazeSolveDispatch(Maze* maze, PathData* pd, MazeAlgorithm algo, MazeMovement movement, const int* costTable) {
+    if (!MazeAlgorithmSupports(algo, movement)) {
+        TraceLog(LOG_WARNING, "%s֧ƶʽ%s", MazeAlgorithmName(algo), MazeMovementName(movement));
+        return false;
+    }
+    // ǽǵб߿ԿԽڽӵķԤ죻ǽʱб߲ͨµķ
+    if (movement != MOVE_8_CORNER_CUT && !MazeEndpointsConnected(maze, pd)) {
+        PathDataReset(pd);
+        TraceLog(LOG_WARNING, "%s㷨δҵɴ·յ㲻ͬһͨ", MazeAlgorithmName(algo));
+        return false;
+    }
+    switch (algo) {
+    case ALGO_DFS:
+    case ALGO_BFS:
+    case ALGO_DIJKSTRA:
+    case ALGO_DIJKSTRA_BUCKET:
+    case ALGO_DIJKSTRA_HEAP:
+    case ALGO_ASTAR:
+        // ÿƶʽʵһںˣб߹ڱȷ
+        if (movement == MOVE_8) return KernelSolve<MOVE_8>(maze, pd, algo, costTable);
+        if (movement == MOVE_8_CORNER_CUT) return KernelSolve<MOVE_8_CORNER_CUT>(maze, pd, algo, costTable);
+        return KernelSolve<MOVE_4>(maze, pd, algo, costTable);
+    case ALGO_JPS:             return JumpPointSearch(maze, pd);
+    case ALGO_BFS_BITS:        return BitParallelBFS(maze, pd);
+    case ALGO_HPA:             return HierarchicalAStar(maze, pd);
+    case ALGO_DSTAR_LITE:      return DStarLiteSolve(maze, pd);
+    case ALGO_BFS_BIDI:        return BidirectionalBFS(maze, pd);
+    case ALGO_DIJKSTRA_BIDI:   return BidirectionalDijkstra(maze, pd, costTable);
+    default:                   return false;
+    }
+}
+
+bool MazeSolve(Maze* maze, PathData* pd, MazeAlgorithm algo) {
+    return MazeSolveWith(maze, pd, algo, MOVE_4, DEFAULT_TERRAIN_COST);
+}
+
+bool MazeSolveWith(Maze* maze, PathData* pd, MazeAlgorithm algo, MazeMovement movement, const int* costTable) {
+#if MAZE_STATS
+    // ʱ·ڴڷͳƣǸ㷨İԤ
+    size_t bytesBefore = PathDataMemoryBytes(pd);
+    auto begin = std::chrono::steady_clock::now();
+    bool found = MazeSolveDispatch(maze, pd, algo, movement, costTable);
+    pd->stats.milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+    size_t bytesAfter = PathDataMemoryBytes(pd);
+    pd->stats.bytesAllocated = bytesAfter > bytesBefore ? bytesAfter - bytesBefore : 0;
+    return found;
+#else
+    return MazeSolveDispatch(maze, pd, algo, movement, costTable);
+#endif
+}
+
+long long MazePathCost(const Maze* maze, const MazePath* path, MazeMovement movement, const int* costTable) {
+    long long total = 0;
+    MazePathIter it;
+    MazePathIterBegin(&it, path);
+    Point prev;
+    Point cell;
+    if (!MazePathIterNext(&it, &prev)) return 0;
+    while (MazePathIterNext(&it, &cell)) {
+        long long cost = TerrainCost(costTable, MazeGetCell(maze, cell.x, cell.y));
+        if (movement != MOVE_4) {
+            bool diagonal = cell.x != prev.x && cell.y != prev.y;
+            cost *= diagonal ? MOVE_DIAGONAL_WEIGHT : MOVE_STRAIGHT_WEIGHT;
+        }
+        total += cost;
+        prev = cell;
+    }
+    return total;
+}
@@ -5,11 +5,75 @@
 #include "maze_config.h"
 #include "maze_utils.h"
 
+// Ѱ·㷨ţmain.cppеּӦ
+typedef enum {
+    ALGO_NONE = 0,
+    ALGO_DFS,
+    ALGO_BFS,
+    ALGO_DIJKSTRA,
+    ALGO_DIJKSTRA_BUCKET,
+    ALGO_DIJKSTRA_HEAP,
+    ALGO_ASTAR,
+    ALGO_JPS,
+    ALGO_BFS_BITS,
+    ALGO_HPA,
+    ALGO_DSTAR_LITE,
+    ALGO_BFS_BIDI,
+    ALGO_DIJKSTRA_BIDI,
+    ALGO_COUNT
+} MazeAlgorithm;
+
+// ƶʽڽӹϵDFSBFSDijkstraA*ػں֧ȫʽ㷨ֻ֧MOVE_4
+typedef enum {
+    MOVE_4 = 0,          // ңÿɱΪӵĵγɱ
+    MOVE_8,              // ˷бʱ붼ͨУǽǣɱMOVE_STRAIGHT/DIAGONAL_WEIGHTȨ
+    MOVE_8_CORNER_CUT,   // ˷ǽб
+    MOVE_COUNT
+} MazeMovement;
+
+// ¸㷨ֱͨԤ죺յ㲻ͨʱճɴ󷵻false
+// ҪپܾɴѯʱMazeSolve/MazeSolveWithֲMazeSearchBeginͬԤ죩
+
 // DFS㷨
 bool DFS(Maze* maze, PathData* pd, int x, int y);
 // BFS㷨
 bool BFS(Maze* maze, PathData* pd);
-// Dijkstra㷨
+// Dijkstra㷨ɨȫͼС룬O(V05)
 bool Dijkstra(Maze* maze, PathData* pd);
+// Dijkstra㷨Ͱ/Dial棬ɱΪСķǸO(V + C)
+bool DijkstraBucket(Maze* maze, PathData* pd, const int* costTable);
+// Dijkstra㷨Ѱ棬ǸɱO(V log V)
+bool DijkstraHeap(Maze* maze, PathData* pd, const int* costTable);
+// A*㷨پСγɱΪ
+bool AStar(Maze* maze, PathData* pd, const int* costTable);
+// JPS4ڽӣڵȴԹݵ/Ұͨ洦
+bool JumpPointSearch(Maze* maze, PathData* pd);
+// λBFSͨиӴΪλͼǰذչֻƲݵ/Ұͨ洦
+bool BitParallelBFS(Maze* maze, PathData* pd);
+// HPA*ֲѰ·ţ״εʱԤֲͼԹ޸ĺͨHpaSetCellͬ
+bool HierarchicalAStar(Maze* maze, PathData* pd);
+// D* Lite滮յ㲻ʱ״̬ƶPathDataSetCell޸ĵؿֻ޸ӰĲ֣
+bool DStarLiteSolve(Maze* maze, PathData* pd);
+// ˫BFSյఴ㽻չÿչǰؽСһ࣬ƴ·
+bool BidirectionalBFS(Maze* maze, PathData* pd);
+// ˫DijkstraཻչѽСһ࣬Ѷ֮ͲС֪·ʱֹͣ
+bool BidirectionalDijkstra(Maze* maze, PathData* pd, const int* costTable);
+// ȡ㷨
+const char* MazeAlgorithmName(MazeAlgorithm algo);
+// ȡƶʽ
+const char* MazeMovementName(MazeMovement movement);
+// 㷨Ƿָ֧ƶʽ
+bool MazeAlgorithmSupports(MazeAlgorithm algo, MazeMovement movement);
+// ִѰ·㷨ڽӣʹĬϵγɱ
+bool MazeSolve(Maze* maze, PathData* pd, MazeAlgorithm algo);
+// ִѰ·㷨ָƶʽγɱɱĬϱͬʱʹñػںˣ
+// JPSBFS(Bits)BFS(Bidi)ƵγɱHPA*D*Lite̶ʹĬϳɱֵ֧ƶʽfalse
+// ǰȲ鹤ͨ״ʹʱյ㲻ͨʱfalse
+bool MazeSolveWith(Maze* maze, PathData* pd, MazeAlgorithm algo, MazeMovement movement, const int* costTable);
+// ͨԤ죨ڽӣյ㶼ͨҷͬʱfalse
+// ˵ԽΪǽʱtrue㷨д
+bool MazeEndpointsConnected(Maze* maze, PathData* pd);
+// ·ɱÿĵγɱ֮ͣ˷ʱֱ/б߼Ȩں˵ļ㷽ʽһ£
+long long MazePathCost(const Maze* maze, const MazePath* path, MazeMovement movement, const int* costTable);
 
 #endif // MAZE_ALGORITHMS_H
\ No newline at end of file
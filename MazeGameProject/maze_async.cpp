@@ -0,0 +1,261 @@
+#include "maze_async.h"
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+
+// ο֮仯ĸӳ1/ASYNC_REBUILD_DIVISORʱ簴GһͬߴԹ
+// ؽͬ
+constexpr int ASYNC_REBUILD_DIVISOR = 16;
+
+struct MazeAsyncSolver {
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable wake;       // ̨֪ͨ߳˳
+    std::atomic<bool> quit;
+    std::atomic<bool> cancel;           // ڽеȡ־cancelָ
+    std::atomic<unsigned int> latest;   // ύȡţ̨߳̾ݴ˶ڽ
+
+    // Ŀգmutex
+    Maze pending;
+    int pendingCapacity;
+    MazeAlgorithm pendingAlgo;
+    unsigned int pendingJob;
+    bool hasPending;
+
+    // ̨߳˽УȡĿաԹ
+    Maze snapshot;
+    int snapshotCapacity;
+    Maze work;
+    int workCapacity;
+    PathData* pd;
+
+    // ˫frontֻȾ߳޸ģreadyΪtrueʱ̨Ⱦ̣߳Ϊfalseʱ̨߳
+    MazeAsyncResult results[2];
+    int front;
+    std::atomic<bool> ready;
+
+    // Ⱦ߳˽
+    unsigned int nextJob;   // һ
+    unsigned int waiting;   // ȴţ0ʾûУ
+};
+
+// ȷ񻺳cells
+static bool ReserveGrid(signed char** grid, int* capacity, int cells) {
+    if (*capacity >= cells) return true;
+    signed char* grown = (signed char*)realloc(*grid, (size_t)cells);
+    if (grown == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ첽Ѱ·Թգ%dӣ", cells);
+        return false;
+    }
+    *grid = grown;
+    *capacity = cells;
+    return true;
+}
+
+// ȡĿͬԹߴ粻ұ仯ʱPathDataSetCell޸ģ򽻻ؽ
+static bool MazeAsyncSync(MazeAsyncSolver* s) {
+    Maze* snap = &s->snapshot;
+    Maze* work = &s->work;
+    int cells = snap->rows * snap->cols;
+    bool rebuild = (s->pd == NULL || snap->rows != work->rows || snap->cols != work->cols);
+    int changed = 0;
+    if (!rebuild) {
+        for (int i = 0; i < cells; i++) {
+            if (snap->grid[i] != work->grid[i]) changed++;
+        }
+        rebuild = (changed > cells / ASYNC_REBUILD_DIVISOR);
+    }
+
+    if (rebuild) {
+        signed char* grid = work->grid;
+        int capacity = s->workCapacity;
+        work->grid = snap->grid;
+        s->workCapacity = s->snapshotCapacity;
+        snap->grid = grid;
+        s->snapshotCapacity = capacity;
+        work->rows = snap->rows;
+        work->cols = snap->cols;
+        work->start = snap->start;
+        work->end = snap->end;
+        if (s->pd != NULL) PathDataDestroy(work, s->pd);
+        s->pd = PathDataCreate(work);
+        if (s->pd == NULL) return false;
+        s->pd->cancel = &s->cancel;
+        return true;
+    }
+
+    for (int i = 0; changed > 0 && i < cells; i++) {
+        if (snap->grid[i] == work->grid[i]) continue;
+        Point p = MazePointFromIndex(work, i);
+        if (!PathDataSetCell(s->pd, work, p.x, p.y, (CellType)snap->grid[i])) return false;
+        changed--;
+    }
+    work->start = snap->start;
+    work->end = snap->end;
+    return true;
+}
+
+// ѽд̨Ⱦ߳δȡһʱȴȴڼ
+static void MazeAsyncPublish(MazeAsyncSolver* s, unsigned int job, MazeAlgorithm algo, bool found, double milliseconds) {
+    while (s->ready.load(std::memory_order_acquire)) {
+        if (s->quit.load(std::memory_order_relaxed) || s->latest.load(std::memory_order_relaxed) != job) return;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    int back = 1 - s->front;
+    MazeAsyncResult* res = &s->results[back];
+    // ·洢ʵʳ֮󷴸
+    if (!found || PathBacktrack(&s->work, s->pd, &res->path) == 0) MazePathClear(&res->path);
+    res->algo = algo;
+    res->expanded = s->pd != NULL ? s->pd->expanded : 0;
+    if (s->pd != NULL) res->stats = s->pd->stats;
+    else memset(&res->stats, 0, sizeof(SearchStats));
+    res->milliseconds = milliseconds;
+    res->job = job;
+    s->ready.store(true, std::memory_order_release);
+}
+
+// ̨̣߳ȴȡ߿պͬⲢ
+static void MazeAsyncThread(MazeAsyncSolver* s) {
+    for (;;) {
+        unsigned int job;
+        MazeAlgorithm algo;
+        {
+            std::unique_lock<std::mutex> lock(s->mutex);
+            s->wake.wait(lock, [&] { return s->quit.load(std::memory_order_relaxed) || s->hasPending; });
+            if (s->quit.load(std::memory_order_relaxed)) return;
+            // ջȾ߳´ύʱдһ
+            signed char* grid = s->snapshot.grid;
+            int capacity = s->snapshotCapacity;
+            s->snapshot = s->pending;
+            s->snapshotCapacity = s->pendingCapacity;
+            s->pending.grid = grid;
+            s->pendingCapacity = capacity;
+            job = s->pendingJob;
+            algo = s->pendingAlgo;
+            s->hasPending = false;
+            // ȡ־ֻڳʱ̵֮ȡ
+            s->cancel.store(false, std::memory_order_relaxed);
+        }
+
+        bool ready = MazeAsyncSync(s);
+        if (!ready && s->pd != NULL) {
+            // ͬ;ʧܣ빤ܲһ£һؽ
+            PathDataDestroy(&s->work, s->pd);
+            s->pd = NULL;
+        }
+        auto begin = std::chrono::steady_clock::now();
+        bool found = ready && MazeSolve(&s->work, s->pd, algo);
+        double milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+        if (s->latest.load(std::memory_order_acquire) != job) {
+            TraceLog(LOG_INFO, "%s%uȡ", MazeAlgorithmName(algo), job);
+            continue;
+        }
+        MazeAsyncPublish(s, job, algo, found, milliseconds);
+    }
+}
+
+MazeAsyncSolver* MazeAsyncCreate(void) {
+    MazeAsyncSolver* s = new (std::nothrow) MazeAsyncSolver();
+    if (s == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ첽ṹ");
+        return NULL;
+    }
+    memset(&s->pending, 0, sizeof(Maze));
+    memset(&s->snapshot, 0, sizeof(Maze));
+    memset(&s->work, 0, sizeof(Maze));
+    memset(s->results, 0, sizeof(s->results));
+    s->pendingCapacity = 0;
+    s->snapshotCapacity = 0;
+    s->workCapacity = 0;
+    s->pendingAlgo = ALGO_NONE;
+    s->pendingJob = 0;
+    s->hasPending = false;
+    s->pd = NULL;
+    MazePathInit(&s->results[0].path, PATH_DIRECTIONS);
+    MazePathInit(&s->results[1].path, PATH_DIRECTIONS);
+    s->front = 0;
+    s->nextJob = 0;
+    s->waiting = 0;
+    s->quit.store(false);
+    s->cancel.store(false);
+    s->latest.store(0);
+    s->ready.store(false);
+    s->thread = std::thread(MazeAsyncThread, s);
+    return s;
+}
+
+void MazeAsyncDestroy(MazeAsyncSolver* solver) {
+    if (solver == NULL) return;
+    {
+        std::lock_guard<std::mutex> lock(solver->mutex);
+        solver->quit.store(true);
+        solver->cancel.store(true);
+    }
+    solver->wake.notify_one();
+    solver->thread.join();
+    if (solver->pd != NULL) PathDataDestroy(&solver->work, solver->pd);
+    free(solver->pending.grid);
+    free(solver->snapshot.grid);
+    free(solver->work.grid);
+    MazePathFree(&solver->results[0].path);
+    MazePathFree(&solver->results[1].path);
+    delete solver;
+}
+
+unsigned int MazeAsyncSubmit(MazeAsyncSolver* solver, const Maze* maze, MazeAlgorithm algo) {
+    int cells = maze->rows * maze->cols;
+    unsigned int job;
+    {
+        std::lock_guard<std::mutex> lock(solver->mutex);
+        if (!ReserveGrid(&solver->pending.grid, &solver->pendingCapacity, cells)) return 0;
+        memcpy(solver->pending.grid, maze->grid, (size_t)cells);
+        solver->pending.rows = maze->rows;
+        solver->pending.cols = maze->cols;
+        solver->pending.start = maze->start;
+        solver->pending.end = maze->end;
+        solver->pendingAlgo = algo;
+        job = ++solver->nextJob;
+        if (job == 0) job = ++solver->nextJob; // 0Ϊ
+        solver->pendingJob = job;
+        solver->hasPending = true;
+        solver->latest.store(job, std::memory_order_release);
+        solver->cancel.store(true, std::memory_order_relaxed); // ڽе췵
+    }
+    solver->wake.notify_one();
+    solver->waiting = job;
+    return job;
+}
+
+void MazeAsyncCancel(MazeAsyncSolver* solver) {
+    std::lock_guard<std::mutex> lock(solver->mutex);
+    // һᱻύıţڽδȡߵĽ֮
+    unsigned int job = ++solver->nextJob;
+    if (job == 0) job = ++solver->nextJob;
+    solver->hasPending = false;
+    solver->latest.store(job, std::memory_order_release);
+    solver->cancel.store(true, std::memory_order_relaxed);
+    solver->waiting = 0;
+}
+
+bool MazeAsyncBusy(const MazeAsyncSolver* solver) {
+    return solver->waiting != 0;
+}
+
+const MazeAsyncResult* MazeAsyncPoll(MazeAsyncSolver* solver) {
+    if (!solver->ready.load(std::memory_order_acquire)) return NULL;
+    int back = 1 - solver->front;
+    if (solver->results[back].job != solver->waiting) {
+        // ֱµύȡȡǰֲ̨
+        solver->ready.store(false, std::memory_order_release);
+        return NULL;
+    }
+    solver->front = back;
+    solver->waiting = 0;
+    solver->ready.store(false, std::memory_order_release);
+    return &solver->results[back];
+}
@@ -0,0 +1,41 @@
+#pragma once
+#ifndef MAZE_ASYNC_H
+#define MAZE_ASYNC_H
+
+#include "maze_config.h"
+#include "maze_algorithms.h"
+
+// 첽Ѱ·פ̨߳⣬Ⱦ߳ύճƣÿ֡ѯһν
+// ύʱԹգ̨߳ԼԹ⣻ο֮仯ĸӾPathDataSetCellͬ
+// λͼֲͼD* Lite״̬Աߴ仯仯ʱؽ
+// µύȡڽе췵أڵĽᷢ
+// ˫壺̨߳д̨λ־Ⱦ߳ѯʱǰ̨ȡǰ̨
+
+// һ첽Ѱ·Ľ
+typedef struct {
+    MazePath path;        // ·㵽յ㣬2λ洢lengthΪ0ʾδҵ·
+    MazeAlgorithm algo;   // 㷨
+    int expanded;         // չĽڵ
+    double milliseconds;  // ̨ʱ룬ͬ
+    SearchStats stats;    // ͳƣMAZE_STATSΪ0ʱȫ0
+    unsigned int job;     // 
+} MazeAsyncResult;
+
+// 첽
+typedef struct MazeAsyncSolver MazeAsyncSolver;
+
+// 첽̨̣߳
+MazeAsyncSolver* MazeAsyncCreate(void);
+// 첽ȡδɵ񲢵ȴ߳˳
+void MazeAsyncDestroy(MazeAsyncSolver* solver);
+// ύѰ·񣺸Թղȡδɵ񣨷ţʧܷ0
+unsigned int MazeAsyncSubmit(MazeAsyncSolver* solver, const Maze* maze, MazeAlgorithm algo);
+// ȡδɵ⵫δȡߵĽͬϣ
+void MazeAsyncCancel(MazeAsyncSolver* solver);
+// Ƿύδȡ߽
+bool MazeAsyncBusy(const MazeAsyncSolver* solver);
+// ѯ½ʱ˫岢ǰ̨һηطNULL֮ǰһֱЧ򷵻NULLȴ
+// Submit/Cancel/Busy/Pollֻͬһ̵߳ã
+const MazeAsyncResult* MazeAsyncPoll(MazeAsyncSolver* solver);
+
+#endif // MAZE_ASYNC_H
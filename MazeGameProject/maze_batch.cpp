@@ -0,0 +1,138 @@
+#include "maze_batch.h"
+
+// һѯĹ
+typedef struct {
+    MazeBatchSolver* solver;
+    const MazeQuery* queries;
+    MazeQueryResult* results;
+} MazeBatchJob;
+
+// ظڵյݣͳƳɱ㹻ʱ㵽յд·
+static void MazeBatchCollect(const Maze* maze, const PathData* pd, int startIndex, int endIndex, MazeQueryResult* res) {
+    int length = 0;
+    long long cost = 0;
+    int current = endIndex;
+    while (current != -1 && length < pd->cellCount) {
+        length++;
+        if (current == startIndex) break;
+        cost += TerrainCost(DEFAULT_TERRAIN_COST, (CellType)maze->grid[current]);
+        current = PathDataParent(pd, current);
+    }
+    if (current != startIndex) {
+        res->found = false;
+        return;
+    }
+    res->pathLength = length;
+    res->cost = cost;
+    if (res->path == NULL || length > res->pathCapacity) return;
+
+    current = endIndex;
+    for (int i = length - 1; i >= 0; i--) {
+        res->path[i] = MazePointFromIndex(maze, current);
+        current = PathDataParent(pd, current);
+    }
+}
+
+// ⵥѯ߳˽еԹ滻/յ㣬޸
+static void MazeBatchTask(int index, int worker, void* context) {
+    MazeBatchJob* job = (MazeBatchJob*)context;
+    const MazeQuery* q = &job->queries[index];
+    MazeQueryResult* res = &job->results[index];
+    Maze local = *job->solver->maze;
+    PathData* pd = job->solver->workspaces[worker];
+
+    res->found = false;
+    res->pathLength = 0;
+    res->cost = 0;
+    res->expanded = 0;
+    if (!IsPointValid(&local, q->start.x, q->start.y) || !IsPointValid(&local, q->end.x, q->end.y)) return;
+    if (MazeGetCell(&local, q->start.x, q->start.y) == CELL_WALL || MazeGetCell(&local, q->end.x, q->end.y) == CELL_WALL) return;
+    // ͨĲѯֱӾܾؽMazeSolveҲʡȥÿѯһ־
+    if (!ComponentIndexConnected(job->solver->components, &local,
+        MazeIndex(&local, q->start.x, q->start.y), MazeIndex(&local, q->end.x, q->end.y))) return;
+
+    local.start = q->start;
+    local.end = q->end;
+    res->found = MazeSolve(&local, pd, job->solver->algo);
+    res->expanded = pd->expanded;
+    if (res->found) {
+        MazeBatchCollect(&local, pd, MazeIndex(&local, q->start.x, q->start.y), MazeIndex(&local, q->end.x, q->end.y), res);
+    }
+}
+
+MazeBatchSolver* MazeBatchCreate(Maze* maze, MazeAlgorithm algo, int threads) {
+    MazeBatchSolver* solver = (MazeBatchSolver*)calloc(1, sizeof(MazeBatchSolver));
+    if (solver == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣṹ");
+        return NULL;
+    }
+    solver->maze = maze;
+    solver->algo = algo;
+    solver->pool = ParallelPoolCreate(threads);
+    if (solver->pool == NULL) {
+        TraceLog(LOG_ERROR, "̳߳شʧ");
+        free(solver);
+        return NULL;
+    }
+    solver->workerCount = ParallelPoolThreadCount(solver->pool);
+    solver->workspaces = (PathData**)calloc((size_t)solver->workerCount, sizeof(PathData*));
+    if (solver->workspaces == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣб");
+        MazeBatchDestroy(solver);
+        return NULL;
+    }
+    // 0ŹֻԤṹ̳߳ص߳нһΣ๤
+    PathData* owner = PathDataCreate(maze);
+    solver->workspaces[0] = owner;
+    if (owner == NULL) {
+        MazeBatchDestroy(solver);
+        return NULL;
+    }
+    owner->threads = solver->workerCount;
+    bool ready = PathDataReserveComponents(owner, maze) != NULL && PathDataReservePadded(owner, maze);
+    if (ready && algo == ALGO_BFS_BITS) ready = PathDataReserveBits(owner, maze);
+    if (ready && algo == ALGO_HPA) ready = PathDataReserveHpa(owner, maze);
+    if (!ready) {
+        MazeBatchDestroy(solver);
+        return NULL;
+    }
+    owner->threads = 1;
+    solver->components = owner->components;
+    for (int w = 1; w < solver->workerCount; w++) {
+        solver->workspaces[w] = PathDataCreate(maze);
+        if (solver->workspaces[w] == NULL) {
+            MazeBatchDestroy(solver);
+            return NULL;
+        }
+        // ߳Ѳ⣬İṹD* Lite滮ȣڱ߳ڽ
+        solver->workspaces[w]->threads = 1;
+        PathDataShare(solver->workspaces[w], owner);
+    }
+    return solver;
+}
+
+void MazeBatchDestroy(MazeBatchSolver* solver) {
+    if (solver == NULL) return;
+    if (solver->workspaces != NULL) {
+        // ÷ͷţ0Źзͷ
+        for (int w = solver->workerCount - 1; w >= 0; w--) {
+            if (solver->workspaces[w] != NULL) PathDataDestroy(solver->maze, solver->workspaces[w]);
+        }
+        free(solver->workspaces);
+    }
+    ParallelPoolDestroy(solver->pool);
+    free(solver);
+}
+
+int MazeBatchSolve(MazeBatchSolver* solver, const MazeQuery* queries, MazeQueryResult* results, int count) {
+    if (solver == NULL || queries == NULL || results == NULL || count <= 0) return 0;
+
+    MazeBatchJob job = { solver, queries, results };
+    ParallelPoolRun(solver->pool, count, MazeBatchTask, &job);
+
+    int found = 0;
+    for (int i = 0; i < count; i++) {
+        if (results[i].found) found++;
+    }
+    return found;
+}
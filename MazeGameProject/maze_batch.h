@@ -0,0 +1,50 @@
+#pragma once
+#ifndef MAZE_BATCH_H
+#define MAZE_BATCH_H
+
+#include "maze_config.h"
+#include "maze_algorithms.h"
+#include "maze_parallel.h"
+#include "maze_components.h"
+
+// Ѱ·ͬһԹϵĴ/յѯָ̳߳ز⡣
+// Թֻÿ̳߳Լѯʱֻ滻/յĸ
+// ·д÷ṩĻвٷڴ棨״ʹʱ⣩
+// ʱ̳߳ص߳нһֻԤṹͨǽ񣬰㷨λͼHPA*ֲͼ
+// ̵߳ĹͬһݣԸƣյ㲻ͨĲѯ
+// ע⣺㷨ÿLOG_INFO־ѯǰӦȵ־
+
+// ѯ
+typedef struct {
+    Point start;  // 
+    Point end;    // յ
+} MazeQuery;
+
+// ѯĽpathpathCapacityɵ÷д
+typedef struct {
+    Point* path;        // ·㵽յ㣻ΪNULLʱֻ㳤ɱ
+    int pathCapacity;   // ɵĸ
+    bool found;         // Ƿҵ·
+    int pathLength;     // ·յ㣻ʱΪʵʳȣ·δд룩
+    long long cost;     // ·ɱĬϳɱۼ֮Ľɱ
+    int expanded;       // չĽڵ
+} MazeQueryResult;
+
+// ɷύѯ
+typedef struct {
+    Maze* maze;             // Թֻ
+    MazeAlgorithm algo;     // ʹõѰ·㷨
+    ParallelPool* pool;     // ȡ̳߳
+    int workerCount;        // ߳
+    PathData** workspaces;  // ÿ߳һ
+    ComponentIndex* components; // õͨ0ŹУֻҲɹ÷ѯӵķǩ
+} MazeBatchSolver;
+
+// threads<=0ʾʹȫӲ̣߳
+MazeBatchSolver* MazeBatchCreate(Maze* maze, MazeAlgorithm algo, int threads);
+// 
+void MazeBatchDestroy(MazeBatchSolver* solver);
+// һѯresults[i]Ӧqueries[i]ҵ·Ĳѯ
+int MazeBatchSolve(MazeBatchSolver* solver, const MazeQuery* queries, MazeQueryResult* results, int count);
+
+#endif // MAZE_BATCH_H
@@ -0,0 +1,414 @@
+#include "maze_bitbfs.h"
+#include "maze_utils.h"
+#include <string.h>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define MAZE_BITBFS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define MAZE_AVX2_TARGET
+#else
+#define MAZE_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+// ʱCPUϵͳǷ֧AVX2
+static bool CpuHasAvx2() {
+#if defined(MAZE_BITBFS_X86) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7) return false;
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 6) != 6) return false;
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#elif defined(MAZE_BITBFS_X86)
+    return __builtin_cpu_supports("avx2") != 0;
+#else
+    return false;
+#endif
+}
+
+// ͳλPOPCNTָ
+static int PopCount(unsigned long long v) {
+    v = v - ((v >> 1) & 0x5555555555555555ULL);
+    v = (v & 0x3333333333333333ULL) + ((v >> 2) & 0x3333333333333333ULL);
+    v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (int)((v * 0x0101010101010101ULL) >> 56);
+}
+
+// Թ±תλͼе±λ
+static int BitWord(const BitGrid* grid, int index) {
+    return (index / grid->cols + 1) * grid->stride + 1 + (index % grid->cols) / 64;
+}
+
+static unsigned long long BitMask(const BitGrid* grid, int index) {
+    return 1ULL << ((index % grid->cols) % 64);
+}
+
+// һУ棩
+static void PackRowScalar(const signed char* cells, int cols, unsigned long long* out) {
+    for (int x = 0; x < cols; x++) {
+        out[x / 64] |= (unsigned long long)(cells[x] != CELL_WALL) << (x % 64);
+    }
+}
+
+#ifdef MAZE_BITBFS_X86
+// һУAVX2棺һαȽ32
+MAZE_AVX2_TARGET static void PackRowAvx2(const signed char* cells, int cols, unsigned long long* out) {
+    const __m256i wall = _mm256_set1_epi8(CELL_WALL);
+    int x = 0;
+    for (; x + 32 <= cols; x += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(cells + x));
+        unsigned int isWall = (unsigned int)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, wall));
+        out[x / 64] |= (unsigned long long)(~isWall) << (x % 64);
+    }
+    for (; x < cols; x++) {
+        out[x / 64] |= (unsigned long long)(cells[x] != CELL_WALL) << (x % 64);
+    }
+}
+#endif
+
+BitGrid* BitGridCreate(const Maze* maze) {
+    BitGrid* grid = (BitGrid*)malloc(sizeof(BitGrid));
+    if (grid == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣͨλͼṹ");
+        return NULL;
+    }
+    grid->rows = maze->rows;
+    grid->cols = maze->cols;
+    grid->stride = (maze->cols + 63) / 64 + 2;
+    grid->wordCount = (maze->rows + 2) * grid->stride;
+    grid->simd = CpuHasAvx2();
+    grid->bits = (unsigned long long*)calloc((size_t)grid->wordCount, sizeof(unsigned long long));
+    if (grid->bits == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣͨλͼ%d %dУ", maze->rows, maze->cols);
+        free(grid);
+        return NULL;
+    }
+
+    for (int y = 0; y < maze->rows; y++) {
+        const signed char* cells = maze->grid + (size_t)y * maze->cols;
+        unsigned long long* out = grid->bits + (size_t)(y + 1) * grid->stride + 1;
+#ifdef MAZE_BITBFS_X86
+        if (grid->simd) {
+            PackRowAvx2(cells, maze->cols, out);
+            continue;
+        }
+#endif
+        PackRowScalar(cells, maze->cols, out);
+    }
+    return grid;
+}
+
+void BitGridDestroy(BitGrid* grid) {
+    if (grid == NULL) return;
+    free(grid->bits);
+    free(grid);
+}
+
+void BitGridSetCell(BitGrid* grid, int index, bool passable) {
+    if (passable) grid->bits[BitWord(grid, index)] |= BitMask(grid, index);
+    else grid->bits[BitWord(grid, index)] &= ~BitMask(grid, index);
+}
+
+BitBfsWork* BitBfsWorkCreate(const BitGrid* grid) {
+    BitBfsWork* work = (BitBfsWork*)calloc(1, sizeof(BitBfsWork));
+    if (work == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣλBFSṹ");
+        return NULL;
+    }
+    work->wordCount = grid->wordCount;
+    work->visited = (unsigned long long*)calloc((size_t)grid->wordCount, sizeof(unsigned long long));
+    work->current = (unsigned long long*)calloc((size_t)grid->wordCount, sizeof(unsigned long long));
+    work->next = (unsigned long long*)calloc((size_t)grid->wordCount, sizeof(unsigned long long));
+    if (work->visited == NULL || work->current == NULL || work->next == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣλBFS");
+        BitBfsWorkDestroy(work);
+        return NULL;
+    }
+    return work;
+}
+
+void BitBfsWorkDestroy(BitBfsWork* work) {
+    if (work == NULL) return;
+    free(work->visited);
+    free(work->current);
+    free(work->next);
+    free(work->levelStart);
+    free(work->entryWord);
+    free(work->entryBits);
+    free(work);
+}
+
+// ȷһ㣨count֣
+static bool ReserveLevel(BitBfsWork* work, int count) {
+    if (work->levelCount + 2 > work->levelCapacity) {
+        int capacity = work->levelCapacity > 0 ? work->levelCapacity * 2 : 1024;
+        int* levels = (int*)realloc(work->levelStart, (size_t)capacity * sizeof(int));
+        if (levels == NULL) return false;
+        work->levelStart = levels;
+        work->levelCapacity = capacity;
+    }
+    if (work->entryCount + count > work->entryCapacity) {
+        int capacity = work->entryCapacity > 0 ? work->entryCapacity : 4096;
+        while (capacity < work->entryCount + count) capacity *= 2;
+        int* words = (int*)realloc(work->entryWord, (size_t)capacity * sizeof(int));
+        if (words == NULL) return false;
+        work->entryWord = words;
+        unsigned long long* bits = (unsigned long long*)realloc(work->entryBits, (size_t)capacity * sizeof(unsigned long long));
+        if (bits == NULL) return false;
+        work->entryBits = bits;
+        work->entryCapacity = capacity;
+    }
+    return true;
+}
+
+// ĳһܵλͬƶֵĽλԼ
+static unsigned long long NextBits(const unsigned long long* cur, int w, int stride) {
+    unsigned long long c = cur[w];
+    return (c << 1) | (c >> 1) | (cur[w - 1] >> 63) | (cur[w + 1] << 63) | cur[w - stride] | cur[w + stride];
+}
+
+// ϡչǰķ֣Ѻѡλϲnext漰ֱ׷Ϊһ
+static int ExpandSparse(const BitGrid* grid, BitBfsWork* work, int first, int last) {
+    const unsigned long long* pass = grid->bits;
+    unsigned long long* visited = work->visited;
+    unsigned long long* next = work->next;
+    int out = work->entryCount;
+    for (int e = first; e < last; e++) {
+        int w = work->entryWord[e];
+        unsigned long long b = work->entryBits[e];
+        // ͬһƶֵĽλ
+        int targets[5] = { w, w - 1, w + 1, w - grid->stride, w + grid->stride };
+        unsigned long long adds[5] = { (b << 1) | (b >> 1), b << 63, b >> 63, b, b };
+        for (int k = 0; k < 5; k++) {
+            int t = targets[k];
+            unsigned long long c = adds[k] & pass[t] & ~visited[t];
+            if (c == 0) continue;
+            if (next[t] == 0) work->entryWord[out++] = t;
+            next[t] |= c;
+        }
+    }
+    for (int i = work->entryCount; i < out; i++) {
+        int w = work->entryWord[i];
+        work->entryBits[i] = next[w];
+        visited[w] |= next[w];
+    }
+    return out - work->entryCount;
+}
+
+// չ棩[w0, w1)Χÿֵһǰ
+static void ExpandDenseScalar(const BitGrid* grid, BitBfsWork* work, int w0, int w1) {
+    const unsigned long long* pass = grid->bits;
+    const unsigned long long* cur = work->current;
+    unsigned long long* visited = work->visited;
+    unsigned long long* next = work->next;
+    int stride = grid->stride;
+    for (int i = w0; i < w1; i++) {
+        unsigned long long n = NextBits(cur, i, stride) & pass[i] & ~visited[i];
+        next[i] = n;
+        visited[i] |= n;
+    }
+}
+
+#ifdef MAZE_BITBFS_X86
+// չAVX2棺һδ4֣
+MAZE_AVX2_TARGET static void ExpandDenseAvx2(const BitGrid* grid, BitBfsWork* work, int w0, int w1) {
+    const unsigned long long* pass = grid->bits;
+    const unsigned long long* cur = work->current;
+    unsigned long long* visited = work->visited;
+    unsigned long long* next = work->next;
+    int stride = grid->stride;
+    int i = w0;
+    for (; i + 4 <= w1; i += 4) {
+        __m256i c = _mm256_loadu_si256((const __m256i*)(cur + i));
+        __m256i left = _mm256_loadu_si256((const __m256i*)(cur + i - 1));
+        __m256i right = _mm256_loadu_si256((const __m256i*)(cur + i + 1));
+        __m256i up = _mm256_loadu_si256((const __m256i*)(cur + i - stride));
+        __m256i down = _mm256_loadu_si256((const __m256i*)(cur + i + stride));
+        __m256i n = _mm256_or_si256(_mm256_slli_epi64(c, 1), _mm256_srli_epi64(c, 1));
+        n = _mm256_or_si256(n, _mm256_or_si256(_mm256_srli_epi64(left, 63), _mm256_slli_epi64(right, 63)));
+        n = _mm256_or_si256(n, _mm256_or_si256(up, down));
+        __m256i p = _mm256_loadu_si256((const __m256i*)(pass + i));
+        __m256i v = _mm256_loadu_si256((const __m256i*)(visited + i));
+        n = _mm256_andnot_si256(v, _mm256_and_si256(n, p));
+        _mm256_storeu_si256((__m256i*)(next + i), n);
+        _mm256_storeu_si256((__m256i*)(visited + i), _mm256_or_si256(v, n));
+    }
+    if (i < w1) ExpandDenseScalar(grid, work, i, w1);
+}
+#endif
+
+// չɨ赱ǰǰУrowLo~rowHi¸һ
+static int ExpandDense(const BitGrid* grid, BitBfsWork* work, int rowLo, int rowHi) {
+    rowLo--;
+    rowHi++;
+    if (rowLo < 1) rowLo = 1;
+    if (rowHi > grid->rows) rowHi = grid->rows;
+    int w0 = rowLo * grid->stride;
+    int w1 = (rowHi + 1) * grid->stride;
+#ifdef MAZE_BITBFS_X86
+    if (grid->simd) ExpandDenseAvx2(grid, work, w0, w1);
+    else ExpandDenseScalar(grid, work, w0, w1);
+#else
+    ExpandDenseScalar(grid, work, w0, w1);
+#endif
+    // ׷Ϊһ
+    int out = work->entryCount;
+    for (int i = w0; i < w1; i++) {
+        if (work->next[i] == 0) continue;
+        work->entryWord[out] = i;
+        work->entryBits[out] = work->next[i];
+        out++;
+    }
+    return out - work->entryCount;
+}
+
+int BitBfsSearch(const BitGrid* grid, BitBfsWork* work, int startIndex, int endIndex) {
+    // һʹλĳУֻ谴
+    for (int e = 0; e < work->entryCount; e++) {
+        work->visited[work->entryWord[e]] = 0;
+    }
+    work->levelCount = 0;
+    work->entryCount = 0;
+    work->visitedCount = 0;
+#if MAZE_STATS
+    memset(&work->stats, 0, sizeof(SearchStats));
+    work->stats.relaxations = STATS_NOT_APPLICABLE;
+#endif
+
+    int startWord = BitWord(grid, startIndex);
+    unsigned long long startBit = BitMask(grid, startIndex);
+    int endWord = BitWord(grid, endIndex);
+    unsigned long long endBit = BitMask(grid, endIndex);
+    if ((grid->bits[startWord] & startBit) == 0 || (grid->bits[endWord] & endBit) == 0) return -1;
+    if (!ReserveLevel(work, 1)) {
+        TraceLog(LOG_ERROR, "ڴʧܣλBFSǰؿ");
+        return -1;
+    }
+
+    // 0㣺
+    work->levelStart[0] = 0;
+    work->entryWord[0] = startWord;
+    work->entryBits[0] = startBit;
+    work->entryCount = 1;
+    work->levelCount = 1;
+    work->levelStart[1] = 1;
+    work->visited[startWord] = startBit;
+    work->current[startWord] = startBit;
+    work->visitedCount = 1;
+    SearchStatsPush(&work->stats, 1);
+
+    int distance = (startIndex == endIndex) ? 0 : -1;
+    int lowWord = startWord;
+    int highWord = startWord;
+    for (int level = 0; distance < 0; level++) {
+        int first = work->levelStart[level];
+        int last = work->levelStart[level + 1];
+
+        // һֻܳڵǰм¸һڣһԤտռ
+        int rowLo = lowWord / grid->stride;
+        int rowHi = highWord / grid->stride;
+        int bandWords = (rowHi - rowLo + 3) * grid->stride;
+        if (!ReserveLevel(work, bandWords)) {
+            TraceLog(LOG_ERROR, "ڴʧܣλBFSǰؿ");
+            for (int e = first; e < last; e++) {
+                work->current[work->entryWord[e]] = 0;
+            }
+            return -1;
+        }
+
+        // ǰжνʱչɨ
+        int count = ((last - first) * 4 < bandWords) ? ExpandSparse(grid, work, first, last) : ExpandDense(grid, work, rowLo, rowHi);
+
+        // ǰӣճǰأnextΪµĵǰ
+        for (int e = first; e < last; e++) {
+            work->current[work->entryWord[e]] = 0;
+            SearchStatsPop(&work->stats);
+        }
+        unsigned long long* swap = work->current;
+        work->current = work->next;
+        work->next = swap;
+        if (count == 0) break; // ǰΪգյ㲻ɴ
+
+        lowWord = work->wordCount;
+        highWord = 0;
+        for (int e = work->entryCount; e < work->entryCount + count; e++) {
+            int w = work->entryWord[e];
+            if (w < lowWord) lowWord = w;
+            if (w > highWord) highWord = w;
+            work->visitedCount += PopCount(work->entryBits[e]);
+            SearchStatsPush(&work->stats, e - work->entryCount + 1);
+        }
+        work->entryCount += count;
+        work->levelCount++;
+        work->levelStart[work->levelCount] = work->entryCount;
+        if (work->current[endWord] & endBit) distance = level + 1;
+    }
+
+    // ղĳǰأ´ʹ
+    int lastLevel = work->levelCount - 1;
+    for (int e = work->levelStart[lastLevel]; e < work->levelStart[lastLevel + 1]; e++) {
+        work->current[work->entryWord[e]] = 0;
+    }
+    return distance;
+}
+
+// ڵlevelвλͼwordظֵλڸòʱΪ0ɨ裩
+static unsigned long long LevelBits(const BitBfsWork* work, int level, int word) {
+    for (int e = work->levelStart[level]; e < work->levelStart[level + 1]; e++) {
+        if (work->entryWord[e] == word) return work->entryBits[e];
+    }
+    return 0;
+}
+
+int BitBfsTrace(const BitGrid* grid, const BitBfsWork* work, int endIndex, int* cells, int maxLen) {
+    static const int dx[4] = { 0, 0, -1, 1 };
+    static const int dy[4] = { -1, 1, 0, 0 };
+
+    // յڲ㼴̲
+    int level = work->levelCount - 1;
+    if (level < 0 || (LevelBits(work, level, BitWord(grid, endIndex)) & BitMask(grid, endIndex)) == 0) return 0;
+    if (level + 1 > maxLen) {
+        TraceLog(LOG_WARNING, "·ݳȳֵ%d", maxLen);
+        return 0;
+    }
+
+    // յˣÿɨһһգһڸòڸӣܴ۲
+    int cur = endIndex;
+    cells[level] = cur;
+    for (int d = level - 1; d >= 0; d--) {
+        int x = cur % grid->cols;
+        int y = cur / grid->cols;
+        int candidates[4];
+        int words[4];
+        unsigned long long masks[4];
+        int count = 0;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + dx[k];
+            int ny = y + dy[k];
+            if (nx < 0 || nx >= grid->cols || ny < 0 || ny >= grid->rows) continue;
+            candidates[count] = ny * grid->cols + nx;
+            words[count] = BitWord(grid, candidates[count]);
+            masks[count] = BitMask(grid, candidates[count]);
+            count++;
+        }
+        int prev = -1;
+        for (int e = work->levelStart[d]; e < work->levelStart[d + 1] && prev < 0; e++) {
+            for (int k = 0; k < count; k++) {
+                if (work->entryWord[e] == words[k] && (work->entryBits[e] & masks[k]) != 0) {
+                    prev = candidates[k];
+                    break;
+                }
+            }
+        }
+        if (prev < 0) return 0;
+        cells[d] = prev;
+        cur = prev;
+    }
+    return level + 1;
+}
@@ -0,0 +1,54 @@
+#pragma once
+#ifndef MAZE_BITBFS_H
+#define MAZE_BITBFS_H
+
+#include "maze_config.h"
+
+// λBFSͨиӴΪÿ1λÿɸ64λ֣ǰλ//һչ
+// ǰؽϡʱֻ֣ϳʱɨǰڵУCPU֧AVX2ʱһδ4֣
+// ÿǰصķΪձ棬ҵյؿݳ·
+
+// ͨλͼֻɱ
+// ÿβһȫ0ı֣¸һȫ0ıУչʱ߽ж
+typedef struct BitGrid {
+    int rows;                   // Թ
+    int cols;                   // Թ
+    int stride;                 // ÿе֣
+    int wordCount;              // (rows+2)*stride
+    bool simd;                  // ǷʹAVX2
+    unsigned long long* bits;   // ͨλǽΪ0
+} BitGrid;
+
+// ÿ߳һ
+typedef struct BitBfsWork {
+    int wordCount;              // λͼ
+    unsigned long long* visited;  // ѷλͼ
+    unsigned long long* current;  // ǰǰأʽ
+    unsigned long long* next;     // һǰأʽ
+    int* levelStart;            // kentryWordеʼλãlevelCount+1
+    int levelCount;             // ѱĲ
+    int levelCapacity;
+    int* entryWord;             // ǰصķ±
+    unsigned long long* entryBits;  // Ӧλ
+    int entryCount;             // ѱĿ
+    int entryCapacity;
+    int visitedCount;           // һʵĸ
+    SearchStats stats;          // һͳƣǰذ64λּƣΪ㱣ķ֣Ϊչյ֣ͳɳڣ
+} BitBfsWork;
+
+// Թͨλͼ
+BitGrid* BitGridCreate(const Maze* maze);
+// ͷſͨλͼ
+void BitGridDestroy(BitGrid* grid);
+// µӵĿͨλΪԹ±꣩
+void BitGridSetCell(BitGrid* grid, int index, bool passable);
+// 
+BitBfsWork* BitBfsWorkCreate(const BitGrid* grid);
+// ͷ
+void BitBfsWorkDestroy(BitBfsWork* work);
+// 㵽յ̲ΪԹ±ꣻɴﷵ-1
+int BitBfsSearch(const BitGrid* grid, BitBfsWork* work, int startIndex, int endIndex);
+// һ·㵽յдԹ±꣨·ʧܷ0
+int BitBfsTrace(const BitGrid* grid, const BitBfsWork* work, int endIndex, int* cells, int maxLen);
+
+#endif // MAZE_BITBFS_H
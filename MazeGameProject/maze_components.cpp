@@ -0,0 +1,229 @@
+#include "maze_components.h"
+#include "maze_parallel.h"
+
+// СԽ࣬кϲĹԽࣩ
+static const int COMPONENT_STRIP_ROWS = 64;
+// ڴֵʱ̱߳ǣ̵߳ĿǱ
+static const int COMPONENT_PARALLEL_CELLS = 1 << 16;
+
+// Ҹѹ·ֻֻѯ
+static int ComponentRoot(const int* parent, int i) {
+    while (parent[i] != i) i = parent[i];
+    return i;
+}
+
+// Ҹѹ·ֻڶռ޸ʱʹã
+static int ComponentFind(int* parent, int i) {
+    int root = ComponentRoot(parent, i);
+    while (parent[i] != root) {
+        int next = parent[i];
+        parent[i] = root;
+        i = next;
+    }
+    return root;
+}
+
+// ϲڵļϣ±ϴĸҵСĸ£ڵϵ±굥ݼǷĺϲ
+static bool ComponentUnion(int* parent, int a, int b) {
+    a = ComponentFind(parent, a);
+    b = ComponentFind(parent, b);
+    if (a == b) return false;
+    if (a < b) parent[b] = a;
+    else parent[a] = b;
+    return true;
+}
+
+// бǵĹ
+typedef struct {
+    ComponentIndex* ci;
+    const Maze* maze;
+    int stripRows;   // ÿ
+    int* roots;      // ѹƽÿڷĸǽΪ-1
+    int* stripRoots; // ÿڵĸķ
+} ComponentBuildJob;
+
+// һ飺ڵĲ鼯ǡϲֻڱĸ֮䣬߳д뻥ཻ
+static void ComponentLabelStrip(int strip, void* context) {
+    ComponentBuildJob* job = (ComponentBuildJob*)context;
+    const Maze* maze = job->maze;
+    int* parent = job->ci->parent;
+    int cols = maze->cols;
+    int y0 = strip * job->stripRows;
+    int y1 = y0 + job->stripRows < maze->rows ? y0 + job->stripRows : maze->rows;
+    for (int y = y0; y < y1; y++) {
+        for (int x = 0; x < cols; x++) {
+            int i = y * cols + x;
+            if (maze->grid[i] == CELL_WALL) {
+                parent[i] = -1;
+                continue;
+            }
+            bool left = x > 0 && maze->grid[i - 1] != CELL_WALL;
+            bool up = y > y0 && maze->grid[i - cols] != CELL_WALL;
+            if (left) {
+                // ¸ֱӹҵڵĸڵ£Ͻǿͨʱͬһϣϲ
+                parent[i] = parent[i - 1];
+                if (up && maze->grid[i - cols - 1] == CELL_WALL) ComponentUnion(parent, i - cols, i);
+            } else if (up) {
+                parent[i] = parent[i - cols];
+            } else {
+                parent[i] = i;
+            }
+        }
+    }
+}
+
+// 飺ѹƽ飨ֻparent߳д뻥ཻͳƱĸ
+// ڵ±겻±ʱڵڱѹƽֱ
+static void ComponentFlattenStrip(int strip, void* context) {
+    ComponentBuildJob* job = (ComponentBuildJob*)context;
+    const Maze* maze = job->maze;
+    const int* parent = job->ci->parent;
+    int begin = strip * job->stripRows * maze->cols;
+    int rowEnd = (strip + 1) * job->stripRows < maze->rows ? (strip + 1) * job->stripRows : maze->rows;
+    int end = rowEnd * maze->cols;
+    int roots = 0;
+    for (int i = begin; i < end; i++) {
+        if (parent[i] < 0) {
+            job->roots[i] = -1;
+            continue;
+        }
+        int p = parent[i];
+        if (p == i) {
+            job->roots[i] = i;
+            roots++;
+        } else {
+            job->roots[i] = p >= begin ? job->roots[p] : ComponentRoot(parent, p);
+        }
+    }
+    job->stripRoots[strip] = roots;
+}
+
+ComponentIndex* ComponentIndexCreate(const Maze* maze, int threads) {
+    ComponentIndex* ci = (ComponentIndex*)malloc(sizeof(ComponentIndex));
+    if (ci == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣͨ");
+        return NULL;
+    }
+    ci->rows = maze->rows;
+    ci->cols = maze->cols;
+    ci->parent = (int*)malloc((size_t)maze->rows * maze->cols * sizeof(int));
+    ci->componentCount = 0;
+    ci->dirty = true;
+    ci->threads = threads;
+    ci->rebuilds = 0;
+    if (ci->parent == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣͨ%d %dУ", maze->rows, maze->cols);
+        ComponentIndexDestroy(ci);
+        return NULL;
+    }
+    if (!ComponentIndexBuild(ci, maze)) {
+        ComponentIndexDestroy(ci);
+        return NULL;
+    }
+    return ci;
+}
+
+void ComponentIndexDestroy(ComponentIndex* ci) {
+    if (ci == NULL) return;
+    free(ci->parent);
+    free(ci);
+}
+
+bool ComponentIndexBuild(ComponentIndex* ci, const Maze* maze) {
+    int cellCount = maze->rows * maze->cols;
+    int threads = cellCount < COMPONENT_PARALLEL_CELLS ? 1 : ParallelThreadCount(ci->threads);
+    // ȡ߳4ңڸؾ
+    int stripRows = (maze->rows + threads * 4 - 1) / (threads * 4);
+    if (stripRows < COMPONENT_STRIP_ROWS) stripRows = COMPONENT_STRIP_ROWS;
+    int strips = (maze->rows + stripRows - 1) / stripRows;
+
+    ComponentBuildJob job;
+    job.ci = ci;
+    job.maze = maze;
+    job.stripRows = stripRows;
+    job.roots = (int*)malloc((size_t)cellCount * sizeof(int));
+    job.stripRoots = (int*)malloc((size_t)strips * sizeof(int));
+    if (job.roots == NULL || job.stripRoots == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣͨǣ%dӣ", cellCount);
+        free(job.roots);
+        free(job.stripRoots);
+        return false;
+    }
+
+    ParallelFor(strips, threads, ComponentLabelStrip, &job);
+    // ڶ飺кϲ紦ֱڱ
+    for (int s = 1; s < strips; s++) {
+        int y = s * stripRows;
+        for (int x = 0; x < maze->cols; x++) {
+            int i = y * maze->cols + x;
+            if (maze->grid[i] != CELL_WALL && maze->grid[i - maze->cols] != CELL_WALL) {
+                ComponentUnion(ci->parent, i - maze->cols, i);
+            }
+        }
+    }
+    ParallelFor(strips, threads, ComponentFlattenStrip, &job);
+
+    // ѹƽֱΪµĸڵ
+    ci->componentCount = 0;
+    for (int s = 0; s < strips; s++) ci->componentCount += job.stripRoots[s];
+    free(ci->parent);
+    free(job.stripRoots);
+    ci->parent = job.roots;
+    ci->rows = maze->rows;
+    ci->cols = maze->cols;
+    ci->dirty = false;
+    ci->rebuilds++;
+    return true;
+}
+
+bool ComponentIndexRefresh(ComponentIndex* ci, const Maze* maze) {
+    if (!ci->dirty) return true;
+    return ComponentIndexBuild(ci, maze);
+}
+
+void ComponentIndexSetCell(ComponentIndex* ci, const Maze* maze, int x, int y, CellType previous) {
+    if (ci->dirty) return;  // ؽʱһ
+    int i = y * maze->cols + x;
+    bool wasOpen = previous != CELL_WALL;
+    bool isOpen = maze->grid[i] != CELL_WALL;
+    if (wasOpen == isOpen) return;  // ݵءҵȿͨеؿ֮лӰͨ
+
+    int neighbors[4];
+    int count = 0;
+    if (x > 0 && maze->grid[i - 1] != CELL_WALL) neighbors[count++] = i - 1;
+    if (x < maze->cols - 1 && maze->grid[i + 1] != CELL_WALL) neighbors[count++] = i + 1;
+    if (y > 0 && maze->grid[i - maze->cols] != CELL_WALL) neighbors[count++] = i - maze->cols;
+    if (y < maze->rows - 1 && maze->grid[i + maze->cols] != CELL_WALL) neighbors[count++] = i + maze->cols;
+
+    if (isOpen) {
+        // סԭϵĸӣԭϿڣֱ
+        if (ci->parent[i] >= 0) {
+            ci->dirty = true;
+            return;
+        }
+        // ¸Գһÿһڷϲһ
+        ci->parent[i] = i;
+        ci->componentCount++;
+        for (int k = 0; k < count; k++) {
+            if (ComponentUnion(ci->parent, i, neighbors[k])) ci->componentCount--;
+        }
+        return;
+    }
+
+    // ȥһڵĸӲʣӣøԭУԿɾҵ
+    if (count >= 2) {
+        ci->dirty = true;
+        return;
+    }
+    if (count == 0) ci->componentCount--;
+}
+
+int ComponentIndexLabel(const ComponentIndex* ci, const Maze* maze, int index) {
+    if (maze->grid[index] == CELL_WALL) return -1;
+    return ComponentRoot(ci->parent, index);
+}
+
+size_t ComponentIndexMemoryBytes(const ComponentIndex* ci) {
+    if (ci == NULL) return 0;
+    return sizeof(ComponentIndex) + (size_t)ci->rows * ci->cols * sizeof(int);
+}
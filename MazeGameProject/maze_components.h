@@ -0,0 +1,46 @@
+#pragma once
+#ifndef MAZE_COMPONENTS_H
+#define MAZE_COMPONENTS_H
+
+#include "maze_config.h"
+
+// ͨڽӰѿͨиӣǽĵؿ飩Ϊͨ
+// յͬʱжɴ
+// ʱ鼯ǣٴкϲ磬ѹƽ
+// ѹƽÿֱָڷĸ±СĸӣѯΪO(1)
+// ޸ĵؿʱάǽֻڷϲסĸһڿͨʱַ
+// Ϊؽ´βѯǰ±ǡ
+// ˵γɱĳֵؿΪͨСбǽʱֻǿɴıҪ
+
+// ͨ
+typedef struct ComponentIndex {
+    int rows;            // Թ
+    int cols;            // Թ
+    int* parent;         // 鼯ڵ㣨δǽΪ-1סδؽĸԭУ
+    int componentCount;  // ͨ
+    bool dirty;          // пַܲ޸ģѯǰؽ
+    int threads;         // ؽʹõ߳<=0ΪȫӲ̣߳
+    int rebuilds;        // ǵĴ״ν
+} ComponentIndex;
+
+// ͨthreadsΪʹõ߳<=0ΪȫӲ̣߳
+ComponentIndex* ComponentIndexCreate(const Maze* maze, int threads);
+// ͷͨ
+void ComponentIndexDestroy(ComponentIndex* ci);
+// ǰԹ±
+bool ComponentIndexBuild(ComponentIndex* ci, const Maze* maze);
+// дؽ޸ʱ±ǣʱֱӷtrue
+bool ComponentIndexRefresh(ComponentIndex* ci, const Maze* maze);
+// Թ(x, y)ѱ޸ĺãpreviousΪ޸ǰĵؿ
+void ComponentIndexSetCell(ComponentIndex* ci, const Maze* maze, int x, int y, CellType previous);
+// ıǩӵ±ꣻǽΪ-1ֻɶ̲߳ѯȷΪ
+int ComponentIndexLabel(const ComponentIndex* ci, const Maze* maze, int index);
+// Ƿͨͬһ
+inline bool ComponentIndexConnected(const ComponentIndex* ci, const Maze* maze, int a, int b) {
+    int label = ComponentIndexLabel(ci, maze, a);
+    return label >= 0 && label == ComponentIndexLabel(ci, maze, b);
+}
+// ͳռõĶڴ棨ֽڣ
+size_t ComponentIndexMemoryBytes(const ComponentIndex* ci);
+
+#endif // MAZE_COMPONENTS_H
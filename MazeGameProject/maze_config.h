@@ -2,11 +2,28 @@
 #ifndef MAZE_CONFIG_H
 #define MAZE_CONFIG_H
 
+#ifndef MAZE_HEADLESS
 #include "raylib.h"
+#else
+// ͼλ׼Եйߣraylibֻṩraylibһµ־ӿ
+typedef enum {
+    LOG_ALL = 0, LOG_TRACE, LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_FATAL, LOG_NONE
+} TraceLogLevel;
+// ־ڵǰ־Ϣԣ
+void TraceLog(int logLevel, const char* text, ...);
+// ־
+void SetTraceLogLevel(int logLevel);
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include <limits.h>
+#include <atomic>
+
+// ͳƿأΪ0ʱ㷨еͳƼȫΪղĿԻжMAZE_STATS=0
+#ifndef MAZE_STATS
+#define MAZE_STATS 1
+#endif
 
 // 
 constexpr int WINDOW_WIDTH = 800;
@@ -17,8 +34,30 @@ constexpr int WINDOW_HEIGHT = 800;
 constexpr int CELL_SIZE = 40;    // ÿشС
 constexpr int CELL_GAP = 1;     // 
 
-// ɫã·ã
+// ɫ
+constexpr float PLAYER_FOLLOW_SPEED = 6.0f; // F·Զߵٶȣ/룩
+
+// 
+constexpr int MAX_SLIMES = 10000;       // ʷķ
+constexpr int INITIAL_SLIMES = 4;       // ÿԹʼʷķ
+constexpr int SLIME_SPAWN_BATCH = 1000; // Cһӵʷķ
+constexpr float SLIME_SPEED = 2.5f;     // ʷķƶٶȣ/룩
+constexpr float SLIME_STEERING = 8.0f;  // תʣÿٶȿ£ı
+constexpr float SLIME_RADIUS = 0.3f;    // ʷķײ뾶
+constexpr float SLIME_SEPARATION = 6.0f; // ʷķ֮ķǿ
+constexpr int SLIME_MAX_NEIGHBORS = 8;  // ÿֻھޣӵʱƵֻĿ
+constexpr int CROWD_THREADS = 1;        // Ⱥ߳1Ϊ̣߳<=0ΪȫӲ̣߳
+
+// ֲãV֡ƽʾѷʼǰأ
+constexpr int SEARCH_NODES_PER_FRAME = 2;       // ÿ֡չĽڵ
+constexpr double SEARCH_FRAME_SECONDS = 0.004;  // ÿ֡ƽʱޣ룩
+#define STATS_LOG_FILE  "maze_stats.csv"         // L׷ͳƵ־ļ.json/.jsonlΪJSON Linesʽ
+
+// ɫã·̵ӣ
 #define COLOR_PATH    Color{255, 255, 0, 120}
+#define COLOR_VISITED  Color{100, 149, 237, 90}
+#define COLOR_FRONTIER Color{255, 140, 0, 150}
+#define COLOR_BACKGROUND  RAYWHITE
 
 // ؿö
 typedef enum {
@@ -30,6 +69,21 @@ typedef enum {
     CELL_LAVA = 3      // 
 } CellType;
 
+// γɱãõؿĴۣCellTypeȡֵ+2Ϊ±꣩
+constexpr int CELL_TYPE_COUNT = 6;
+constexpr int COST_IMPASSABLE = -1;  // ͨ
+constexpr int DEFAULT_TERRAIN_COST[CELL_TYPE_COUNT] = {
+    1,                 // յ
+    1,                 // 
+    1,                 // ͨ
+    COST_IMPASSABLE,   // ǽ
+    3,                 // ݵ
+    1000               // 
+};
+// ˷ƶĳɱֱΪγɱ5бΪ7ԼΪ2ƣɱλΪ1/5
+constexpr int MOVE_STRAIGHT_WEIGHT = 5;
+constexpr int MOVE_DIAGONAL_WEIGHT = 7;
+
 // ṹ
 typedef struct {
     int x;  // 
@@ -40,16 +94,59 @@ typedef struct {
 typedef struct {
     int rows;          // Թ
     int cols;          // Թ
-    CellType** grid;   // Թ
+    signed char* grid; // Թݣ洢ÿ1ֽڣֵΪCellType
+    void* mapping;     // 㿽ʱڴӳ䣨NULLʱgridָӳfree
     Point start;       // 
     Point end;         // յ
 } Maze;
 
-// ·ݽṹ
+// Ը㷨ûʱȡֵΪn/a
+constexpr long long STATS_NOT_APPLICABLE = -1;
+
+// ͳƣMAZE_STATSΪ0ʱȫ0
+// HPA*ֻͳƳͼϵBFS(Bits)ǰذ64λּƣûڱߵɳڣrelaxationsΪSTATS_NOT_APPLICABLE
+typedef struct {
+    long long pushes;       // /ջ/Ѵͼֵ
+    long long pops;         // /ջ/Ѵ
+    long long relaxations;  // ڱھӣJPSΪԾ
+    int peakFrontier;       // ǰأ/ջ/бķֵС
+    size_t bytesAllocated;  // ·Ĺڴ棨ĶСѡֲͼȣ
+    double milliseconds;    // ǽӺʱ룬MazeSolveͳƣ
+} SearchStats;
+
+// ·ݽṹ壨
+// ԹߴһΡɷڶ鰴±꣨MazeIndexʡ
+// stamp[i]==generationʾѷָøparent/distanceЧ
+// stamp[i]==generation+1ʾȷDijkstraȳӣֵΪδʣ
+// ˿ʼֻgeneration2顣
 typedef struct {
-    bool** visited;    // ʱ
-    Point** parent;    // ڵ㣨·ݣ
-    int** distance;    // 루Dijkstraã
+    int cellCount;            // 
+    unsigned int generation;  // ǰ
+    unsigned int* stamp;      // ÿķʴ
+    int* parent;              // ڵ±꣨·ݣ-1ʾޣ
+    int* distance;            // 루BFSΪDijkstraΪɱ
+    int* queue;               // BFS/DFSջ䣩
+    unsigned char* dirStack;  // DFSջ֡һ򣨰䣩
+    struct IndexedHeap* heap;    // ѣ䣩
+    struct BucketQueue* buckets; // ͰУ䣩
+    struct BitGrid* bitGrid;     // λBFSĿͨλͼ
+    struct BitBfsWork* bitWork;  // λBFS䣩
+    struct HpaGraph* hpa;        // HPA*ֲͼԤ
+    struct HpaSearch* hpaSearch; // HPA*ѯ䣩
+    struct DStarLite* dstar;     // D* Lite滮䣬״̬
+    unsigned int* backStamp;     // ˫һķʴţ䣬generationã
+    int* backParent;             // һĺ±꣨յ㷽-1ʾޣ
+    int* backDistance;           // һൽյľ
+    int* backQueue;              // BFSУ䣩
+    struct IndexedHeap* backHeap; // Dijkstraѣ䣩
+    signed char* padGrid;        // ܲһȦǽ񸱱(rows+2)*(cols+2)踴ƣں˽ʡȥԽжϣ
+    size_t padBytes;             // ǽֽ
+    struct ComponentIndex* components; // ͨ轨ǰȾݴ˾ܾɴĲѯ
+    bool preprocessShared;       // ǽλͼֲͼһĸ̹߳һݣֻ汾ͷţ
+    int expanded;             // չ/ǷʣĽڵ
+    int threads;              // ԤHPA*ֲͼͨʹõ߳<=0ΪȫӲ̣߳÷ѰʱΪ1
+    const std::atomic<bool>* cancel; // ȡ־NULLұλʱ췵false첽ã
+    SearchStats stats;        // ͳƣPathDataResetʱ㣩
 } PathData;
 
 #endif // MAZE_CONFIG_H
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "maze_crowd.h"
+#include <math.h>
+#include <string.h>
+#include <chrono>
+
+// ÿĸ԰˳
+static const int CROWD_CHUNK = 1024;
+
+Crowd* CrowdCreate(int capacity, int threads) {
+    Crowd* crowd = (Crowd*)calloc(1, sizeof(Crowd));
+    if (crowd == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣȺṹ");
+        return NULL;
+    }
+    crowd->capacity = capacity > 0 ? capacity : 1;
+    size_t n = (size_t)crowd->capacity;
+    int buckets = 1;
+    while (buckets < crowd->capacity * 2) buckets <<= 1;
+    crowd->bucketMask = buckets - 1;
+
+    crowd->posX = (float*)malloc(n * sizeof(float));
+    crowd->posY = (float*)malloc(n * sizeof(float));
+    crowd->velX = (float*)malloc(n * sizeof(float));
+    crowd->velY = (float*)malloc(n * sizeof(float));
+    crowd->targetX = (float*)malloc(n * sizeof(float));
+    crowd->targetY = (float*)malloc(n * sizeof(float));
+    crowd->state = (unsigned char*)malloc(n);
+    crowd->nextX = (float*)malloc(n * sizeof(float));
+    crowd->nextY = (float*)malloc(n * sizeof(float));
+    crowd->pushX = (float*)malloc(n * sizeof(float));
+    crowd->pushY = (float*)malloc(n * sizeof(float));
+    crowd->cell = (int*)malloc(n * sizeof(int));
+    crowd->bucketStart = (int*)malloc(((size_t)buckets + 1) * sizeof(int));
+    crowd->bucketAgents = (int*)malloc(n * sizeof(int));
+    if (crowd->posX == NULL || crowd->posY == NULL || crowd->velX == NULL || crowd->velY == NULL ||
+        crowd->targetX == NULL || crowd->targetY == NULL || crowd->state == NULL || crowd->nextX == NULL ||
+        crowd->nextY == NULL || crowd->pushX == NULL || crowd->pushY == NULL || crowd->cell == NULL ||
+        crowd->bucketStart == NULL || crowd->bucketAgents == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣȺ壨%d", crowd->capacity);
+        CrowdDestroy(crowd);
+        return NULL;
+    }
+    memset(crowd->bucketStart, 0, ((size_t)buckets + 1) * sizeof(int));
+
+    // ߳ʱ̳߳أ̳߳شʧʱ˻ص߳
+    if (ParallelThreadCount(threads) > 1) {
+        crowd->pool = ParallelPoolCreate(threads);
+        if (crowd->pool == NULL) TraceLog(LOG_WARNING, "Ⱥ̳߳شʧܣΪ̸߳");
+    }
+    return crowd;
+}
+
+void CrowdDestroy(Crowd* crowd) {
+    if (crowd == NULL) return;
+    ParallelPoolDestroy(crowd->pool);
+    free(crowd->posX);
+    free(crowd->posY);
+    free(crowd->velX);
+    free(crowd->velY);
+    free(crowd->targetX);
+    free(crowd->targetY);
+    free(crowd->state);
+    free(crowd->nextX);
+    free(crowd->nextY);
+    free(crowd->pushX);
+    free(crowd->pushY);
+    free(crowd->cell);
+    free(crowd->bucketStart);
+    free(crowd->bucketAgents);
+    free(crowd);
+}
+
+// 嵱ǰλؽռϣͳÿͰǰ׺͡룩
+static void CrowdBuildHash(Crowd* crowd, const Maze* maze) {
+    int buckets = crowd->bucketMask + 1;
+    int* start = crowd->bucketStart;
+    memset(start, 0, ((size_t)buckets + 1) * sizeof(int));
+    for (int i = 0; i < crowd->count; i++) {
+        int c = (int)crowd->posY[i] * maze->cols + (int)crowd->posX[i];
+        crowd->cell[i] = c;
+        start[(c & crowd->bucketMask) + 1]++;
+    }
+    for (int b = 0; b < buckets; b++) start[b + 1] += start[b];
+    // ʱstart[b]ƵһͰ㣬һλԭ
+    for (int i = 0; i < crowd->count; i++) {
+        int b = crowd->cell[i] & crowd->bucketMask;
+        crowd->bucketAgents[start[b]++] = i;
+    }
+    for (int b = buckets; b > 0; b--) start[b] = start[b - 1];
+    start[0] = 0;
+    crowd->hashStale = false;
+}
+
+void CrowdClear(Crowd* crowd) {
+    crowd->count = 0;
+    memset(crowd->bucketStart, 0, ((size_t)crowd->bucketMask + 2) * sizeof(int));
+    crowd->hashStale = false;
+}
+
+bool CrowdAdd(Crowd* crowd, Point cell) {
+    if (crowd->count >= crowd->capacity) return false;
+    int i = crowd->count++;
+    crowd->posX[i] = cell.x + 0.5f;
+    crowd->posY[i] = cell.y + 0.5f;
+    crowd->velX[i] = 0.0f;
+    crowd->velY[i] = 0.0f;
+    crowd->targetX[i] = crowd->posX[i];
+    crowd->targetY[i] = crowd->posY[i];
+    crowd->state[i] = AGENT_IDLE;
+    crowd->cell[i] = -1; // ´θǰڿռϣ
+    crowd->hashStale = true;
+    return true;
+}
+
+// Ƿ赲壨ǽԹ⣩
+static bool CrowdBlocked(const Maze* maze, float x, float y) {
+    if (x < 0.0f || y < 0.0f) return true;
+    int cx = (int)x;
+    int cy = (int)y;
+    if (cx >= maze->cols || cy >= maze->rows) return true;
+    return maze->grid[cy * maze->cols + cx] == CELL_WALL;
+}
+
+// Ŀÿֻؾ볡ȡһΪĿ꣬Χ3x3ڵھ໥ƿ
+static void CrowdSteer(Crowd* crowd, const Maze* maze, const DistanceField* field, int begin, int end) {
+    const float minDist = SLIME_RADIUS * 2.0f;
+    for (int i = begin; i < end; i++) {
+        float px = crowd->posX[i];
+        float py = crowd->posY[i];
+        Point here = { (int)px, (int)py };
+        Point next = DistanceFieldNextStep(field, here);
+        crowd->targetX[i] = next.x + 0.5f;
+        crowd->targetY[i] = next.y + 0.5f;
+        crowd->state[i] = (unsigned char)(next.x == here.x && next.y == here.y ? AGENT_IDLE : AGENT_CHASE);
+
+        float fx = 0.0f;
+        float fy = 0.0f;
+        int seen = 0;
+        for (int dy = -1; dy <= 1 && seen < SLIME_MAX_NEIGHBORS; dy++) {
+            int ny = here.y + dy;
+            if (ny < 0 || ny >= maze->rows) continue;
+            for (int dx = -1; dx <= 1 && seen < SLIME_MAX_NEIGHBORS; dx++) {
+                int nx = here.x + dx;
+                if (nx < 0 || nx >= maze->cols) continue;
+                int c = ny * maze->cols + nx;
+                int b = c & crowd->bucketMask;
+                for (int k = crowd->bucketStart[b]; k < crowd->bucketStart[b + 1] && seen < SLIME_MAX_NEIGHBORS; k++) {
+                    int j = crowd->bucketAgents[k];
+                    // ͬӿͬһͰֻȡȷʵλڸøĸ
+                    if (j == i || crowd->cell[j] != c) continue;
+                    float ox = px - crowd->posX[j];
+                    float oy = py - crowd->posY[j];
+                    float d2 = ox * ox + oy * oy;
+                    if (d2 >= minDist * minDist) continue;
+                    seen++;
+                    float d = sqrtf(d2);
+                    float strength = (minDist - d) / minDist;
+                    if (d < 1e-4f) {
+                        // ȫغʱŷֿ
+                        ox = i < j ? 1.0f : -1.0f;
+                        oy = 0.0f;
+                        d = 1.0f;
+                    }
+                    fx += ox / d * strength;
+                    fy += oy / d * strength;
+                }
+            }
+        }
+        crowd->pushX[i] = fx * SLIME_SEPARATION;
+        crowd->pushY[i] = fy * SLIME_SEPARATION;
+    }
+}
+
+// ںˣϵ޷֧㣨Ŀת򡢽ӽĿʱ١ӷ١λƣ
+static void CrowdIntegrate(int n, float dt, const float* __restrict px, const float* __restrict py,
+    float* __restrict vx, float* __restrict vy, const float* __restrict tx, const float* __restrict ty,
+    const float* __restrict fx, const float* __restrict fy, float* __restrict nx, float* __restrict ny) {
+    const float steer = fminf(1.0f, SLIME_STEERING * dt);
+    const float maxSpeed = SLIME_SPEED * 2.0f;
+    for (int i = 0; i < n; i++) {
+        float dx = tx[i] - px[i];
+        float dy = ty[i] - py[i];
+        float len = sqrtf(dx * dx + dy * dy) + 1e-6f;
+        float speed = SLIME_SPEED * fminf(1.0f, len * 2.0f) / len;
+        float ux = vx[i] + (dx * speed - vx[i]) * steer + fx[i] * dt;
+        float uy = vy[i] + (dy * speed - vy[i]) * steer + fy[i] * dt;
+        ux = fmaxf(-maxSpeed, fminf(maxSpeed, ux));
+        uy = fmaxf(-maxSpeed, fminf(maxSpeed, uy));
+        vx[i] = ux;
+        vy[i] = uy;
+        nx[i] = px[i] + ux * dt;
+        ny[i] = py[i] + uy * dt;
+    }
+}
+
+// ǽײƶxƶyᣬǰԵļӰ뾶ǽʱ˻ԭλٶ
+static void CrowdCollide(Crowd* crowd, const Maze* maze, int begin, int end) {
+    for (int i = begin; i < end; i++) {
+        float px = crowd->posX[i];
+        float py = crowd->posY[i];
+        float nx = crowd->nextX[i];
+        float ny = crowd->nextY[i];
+        float edgeX = nx + (nx > px ? SLIME_RADIUS : -SLIME_RADIUS);
+        if (CrowdBlocked(maze, edgeX, py)) {
+            nx = px;
+            crowd->velX[i] = 0.0f;
+        }
+        float edgeY = ny + (ny > py ? SLIME_RADIUS : -SLIME_RADIUS);
+        if (CrowdBlocked(maze, nx, edgeY)) {
+            ny = py;
+            crowd->velY[i] = 0.0f;
+        }
+        // ǽʱǽձ£ԭλ
+        if (CrowdBlocked(maze, nx, ny)) {
+            nx = px;
+            ny = py;
+        }
+        crowd->nextX[i] = nx;
+        crowd->nextY[i] = ny;
+    }
+}
+
+// иµ
+typedef struct {
+    Crowd* crowd;
+    const Maze* maze;
+    const DistanceField* field;
+    float dt;
+} CrowdUpdateContext;
+
+// һ壺ֻһ֡λռϣֻдٶȡĿһ֡λ
+static void CrowdUpdateChunk(int index, int worker, void* context) {
+    (void)worker;
+    CrowdUpdateContext* ctx = (CrowdUpdateContext*)context;
+    Crowd* c = ctx->crowd;
+    int begin = index * CROWD_CHUNK;
+    int end = begin + CROWD_CHUNK < c->count ? begin + CROWD_CHUNK : c->count;
+    CrowdSteer(c, ctx->maze, ctx->field, begin, end);
+    CrowdIntegrate(end - begin, ctx->dt, c->posX + begin, c->posY + begin, c->velX + begin, c->velY + begin,
+        c->targetX + begin, c->targetY + begin, c->pushX + begin, c->pushY + begin, c->nextX + begin, c->nextY + begin);
+    CrowdCollide(c, ctx->maze, begin, end);
+}
+
+void CrowdUpdate(Crowd* crowd, const Maze* maze, const DistanceField* field, float dt) {
+    if (crowd->count == 0) return;
+    auto begin = std::chrono::steady_clock::now();
+    // ֡ʱ϶ڣʱƵ⴩ǽ
+    if (dt > 0.05f) dt = 0.05f;
+
+    // ռϣϴθ½ʱѰǰλý֮¼ʱؽ
+    if (crowd->hashStale) CrowdBuildHash(crowd, maze);
+    CrowdUpdateContext ctx = { crowd, maze, field, dt };
+    int chunks = (crowd->count + CROWD_CHUNK - 1) / CROWD_CHUNK;
+    if (crowd->pool != NULL && chunks > 1) ParallelPoolRun(crowd->pool, chunks, CrowdUpdateChunk, &ctx);
+    else {
+        for (int k = 0; k < chunks; k++) CrowdUpdateChunk(k, 0, &ctx);
+    }
+
+    // ˫壬λؽռϣѯʹ
+    float* t = crowd->posX;
+    crowd->posX = crowd->nextX;
+    crowd->nextX = t;
+    t = crowd->posY;
+    crowd->posY = crowd->nextY;
+    crowd->nextY = t;
+    CrowdBuildHash(crowd, maze);
+    crowd->milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+}
+
+int CrowdFindInCell(const Crowd* crowd, const Maze* maze, int x, int y) {
+    if (x < 0 || x >= maze->cols || y < 0 || y >= maze->rows) return -1;
+    int c = y * maze->cols + x;
+    int b = c & crowd->bucketMask;
+    for (int k = crowd->bucketStart[b]; k < crowd->bucketStart[b + 1]; k++) {
+        int i = crowd->bucketAgents[k];
+        if (crowd->cell[i] == c) return i;
+    }
+    // ϴθº¼ĸδռϣ
+    if (!crowd->hashStale) return -1;
+    for (int i = 0; i < crowd->count; i++) {
+        if (crowd->cell[i] < 0 && (int)crowd->posX[i] == x && (int)crowd->posY[i] == y) return i;
+    }
+    return -1;
+}
@@ -0,0 +1,68 @@
+#pragma once
+#ifndef MAZE_CROWD_H
+#define MAZE_CROWD_H
+
+#include "maze_config.h"
+#include "maze_field.h"
+#include "maze_parallel.h"
+
+// ʷķȺ壺ǧֻʷķڸӼƶ
+// ״ֶ̬ηţSoAλáٶȡĿꡢ״̬һ飩ÿ֡ͳһ£
+//   1. ռϣ±Ͱ-1λõͰţͰΪ2ݡ2ԹС޹أ
+//      ͬӿͬһͰѯʱٰӹˣͰO(n)
+//   2. ÿֻؾ볡һΪĿ꣨O(1)Χ3x3ھۼƷ
+//   3. ϵ޷֧ںˣתᡢλƣԶ
+//   4. ǽˣ֤ǽ
+// 2~4ֻһ֡λáд֡λã˫壩ɰָ̳߳زִС
+// ԸΪλ(x, y)[x, x+1) x [y, y+1)Ϊ(x+0.5, y+0.5)
+// ע⣺ģ鲻raylibƣͼλ
+
+// ״̬
+typedef enum {
+    AGENT_IDLE = 0,   // Ŀ޷Ŀ꣬ԭͣ
+    AGENT_CHASE       // ؾ볡׷Ŀ
+} AgentState;
+
+// Ⱥ壨SoA
+typedef struct {
+    int count;                   // ǰ
+    int capacity;                // 
+    float* posX;                 // λãӵλ
+    float* posY;
+    float* velX;                 // ٶȣ/룩
+    float* velY;
+    float* targetX;              // ǰĿ㣨һģ
+    float* targetY;
+    unsigned char* state;        // ״̬AgentState
+    float* nextX;                // ֽ֡˫壬½pos
+    float* nextY;
+    float* pushX;                // ֡ۼƵķ
+    float* pushY;
+    int* cell;                   // ڸ±꣨ռϣʱ¼
+    int bucketMask;              // ռϣͰ-1ͰΪ2ݣ2
+    int* bucketStart;            // ÿͰbucketAgentsеʼλãͰ+1
+    int* bucketAgents;           // Ͱеĸ
+    bool hashStale;              // иδռϣϴθº˸壩
+    ParallelPool* pool;          // ̳߳أ̸߳ʱΪNULL
+    double milliseconds;         // һθºʱ룩
+} Crowd;
+
+// Ⱥ壨threadsΪʹõ߳1Ϊ̣߳<=0ΪȫӲ̣߳
+Crowd* CrowdCreate(int capacity, int threads);
+// ͷȺ壨ȴ̳߳˳
+void CrowdDestroy(Crowd* crowd);
+// и
+void CrowdClear(Crowd* crowd);
+// ڸһ壨ʱfalse
+bool CrowdAdd(Crowd* crowd, Point cell);
+// ƽdt룺ؾ볡׷١롢ֲǽײ볡ѰǰԹ£
+void CrowdUpdate(Crowd* crowd, const Maze* maze, const DistanceField* field, float dt);
+// λָӵһ壨ռϣÿθºλؽûʱ-1
+int CrowdFindInCell(const Crowd* crowd, const Maze* maze, int x, int y);
+// ڸ
+inline Point CrowdAgentCell(const Crowd* crowd, int i) {
+    Point p = { (int)crowd->posX[i], (int)crowd->posY[i] };
+    return p;
+}
+
+#endif // MAZE_CROWD_H
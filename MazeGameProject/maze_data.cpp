@@ -1,4 +1,7 @@
 #include "maze_data.h"
+#include "maze_utils.h"
+#include "maze_mmap.h"
+#include <string.h>
 
 Maze* MazeCreate() {
     Maze* maze = (Maze*)malloc(sizeof(Maze));
@@ -9,6 +12,7 @@ Maze* MazeCreate() {
     maze->rows = 0;
     maze->cols = 0;
     maze->grid = NULL;
+    maze->mapping = NULL;
     // C++ݵĽṹʼ
     maze->start.x = -1;
     maze->start.y = -1;
@@ -17,104 +21,276 @@ Maze* MazeCreate() {
     return maze;
 }
 
-void MazeDestroy(Maze* maze) {
-    if (maze == NULL) return;
-    if (maze->grid != NULL) {
-        for (int i = 0; i < maze->rows; i++) {
-            free(maze->grid[i]);
-        }
+// ͷֶڴڴӳ䣩
+static void MazeReleaseGrid(Maze* maze) {
+    if (maze->mapping != NULL) {
+        MappedFileClose((MappedFile*)maze->mapping);
+        free(maze->mapping);
+        maze->mapping = NULL;
+    }
+    else {
         free(maze->grid);
     }
+    maze->grid = NULL;
+}
+
+void MazeDestroy(Maze* maze) {
+    if (maze == NULL) return;
+    MazeReleaseGrid(maze);
     free(maze);
 }
 
-bool MazeLoadFromFile(Maze* maze, const char* filename) {
-    FILE* file = NULL;
-    errno_t err = fopen_s(&file, filename, "r"); // fopen_sش룬ֱӷָ
-    if (err != 0 || file == NULL) { // жϴ룬жָ
-        TraceLog(LOG_ERROR, "޷Թļ: %s", filename);
+// ϷԣintΧڣԱint±꣩
+static bool MazeCheckSize(int rows, int cols) {
+    if (rows <= 0 || cols <= 0 || rows > INT_MAX / cols) {
+        TraceLog(LOG_ERROR, "ԹǷ%d %d", rows, cols);
         return false;
     }
+    return true;
+}
 
-    // ȡ
-    if (fscanf_s(file, "%d %d", &maze->rows, &maze->cols) != 2) {
-        TraceLog(LOG_ERROR, "ԹļʽΪ");
-        fclose(file);
+bool MazeAllocate(Maze* maze, int rows, int cols) {
+    MazeReleaseGrid(maze);
+    maze->rows = 0;
+    maze->cols = 0;
+    if (!MazeCheckSize(rows, cols)) return false;
+
+    // ڴ棨ÿ1ֽڣ
+    maze->grid = (signed char*)malloc((size_t)rows * cols);
+    if (maze->grid == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣԹ%d %dУ", rows, cols);
         return false;
     }
+    maze->rows = rows;
+    maze->cols = cols;
+    return true;
+}
+
+// ȡһʮǰհףָ֧ţɹƶα
+static bool ScanInt(const unsigned char** cursor, const unsigned char* end, int* out) {
+    const unsigned char* p = *cursor;
+    while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    if (p >= end) return false;
+
+    bool negative = (*p == '-');
+    if (negative) p++;
+    if (p >= end || (unsigned)(*p - '0') > 9) return false;
+
+    long long value = 0;
+    while (p < end && (unsigned)(*p - '0') <= 9) {
+        value = value * 10 + (*p - '0');
+        if (value > INT_MAX) return false;
+        p++;
+    }
+    *out = negative ? -(int)value : (int)value;
+    *cursor = p;
+    return true;
+}
 
-    // Ϸԣ20x20
-    if (maze->rows <= 0 || maze->cols <= 0 || maze->rows > 20 || maze->cols > 20) {
-        TraceLog(LOG_ERROR, "ԹΪ1-20");
-        fclose(file);
+// ¼һؿ飨/յ㣩ȡֵǷʱfalse
+static bool MazeRecordCell(Maze* maze, int index, int val, int* startCount, int* endCount) {
+    if (val >= CELL_GROUND && val <= CELL_LAVA) return true;
+    Point pos = { index % maze->cols, index / maze->cols };
+    if (val == CELL_START) {
+        maze->start = pos;
+        (*startCount)++;
+        return true;
+    }
+    if (val == CELL_END) {
+        maze->end = pos;
+        (*endCount)++;
+        return true;
+    }
+    TraceLog(LOG_ERROR, "ԹļؿͷǷ%d%d%d", pos.y + 1, pos.x + 1, val);
+    return false;
+}
+
+// У/յ
+static bool MazeCheckEndpoints(int startCount, int endCount) {
+    if (startCount != 1) {
+        TraceLog(LOG_ERROR, "Թҽ1㣨ǰ%d", startCount);
+        return false;
+    }
+    if (endCount != 1) {
+        TraceLog(LOG_ERROR, "Թҽ1յ㣨ǰ%d", endCount);
         return false;
     }
+    return true;
+}
 
-    // ڴ
-    maze->grid = (CellType**)malloc(maze->rows * sizeof(CellType*));
-    if (maze->grid == NULL) {
-        TraceLog(LOG_ERROR, "ڴʧܣԹ");
-        fclose(file);
+// ıʽΪΪrows*colsԿհ׷ָ
+static bool MazeParseText(Maze* maze, const unsigned char* text, size_t size) {
+    const unsigned char* p = text;
+    const unsigned char* end = text + size;
+
+    // ȡ
+    int rows, cols;
+    if (!ScanInt(&p, end, &rows) || !ScanInt(&p, end, &cols)) {
+        TraceLog(LOG_ERROR, "ԹļʽΪ");
         return false;
     }
-    for (int i = 0; i < maze->rows; i++) {
-        maze->grid[i] = (CellType*)malloc(maze->cols * sizeof(CellType));
-        if (maze->grid[i] == NULL) {
-            TraceLog(LOG_ERROR, "ڴʧܣԹ");
-            // ͷѷڴ
-            for (int j = 0; j < i; j++) {
-                free(maze->grid[j]);
-            }
-            free(maze->grid);
-            fclose(file);
+    if (!MazeAllocate(maze, rows, cols)) return false;
+    signed char* grid = maze->grid;
+
+    // һɨȡݣͬʱ¼/յ
+    int startCount = 0, endCount = 0;
+    int total = rows * cols;
+    for (int i = 0; i < total; i++) {
+        int val;
+        // ·Ǹֺհף
+        if (p + 1 < end && (unsigned)(p[0] - '0') <= 9 && (p[1] == ' ' || p[1] == '\n' || p[1] == '\r' || p[1] == '\t')) {
+            val = p[0] - '0';
+            p += 2;
+        }
+        else if (!ScanInt(&p, end, &val)) {
+            TraceLog(LOG_ERROR, "Թļݲ%d%d", i / cols + 1, i % cols + 1);
+            MazeReleaseGrid(maze);
             return false;
         }
+        if (!MazeRecordCell(maze, i, val, &startCount, &endCount)) {
+            MazeReleaseGrid(maze);
+            return false;
+        }
+        grid[i] = (signed char)val;
     }
 
-    // ȡݣ¼/յ
-    int startCount = 0, endCount = 0;
-    for (int y = 0; y < maze->rows; y++) {
-        for (int x = 0; x < maze->cols; x++) {
-            int val;
-            if (fscanf_s(file, "%d", &val) != 1) {
-                TraceLog(LOG_ERROR, "Թļݲ%d%d", y + 1, x + 1);
-                // ͷڴ
-                for (int j = 0; j < maze->rows; j++) {
-                    free(maze->grid[j]);
-                }
-                free(maze->grid);
-                fclose(file);
-                return false;
-            }
-            maze->grid[y][x] = (CellType)val;
+    return MazeCheckEndpoints(startCount, endCount);
+}
 
-            // ¼/յ
-            if (maze->grid[y][x] == CELL_START) {
-                maze->start.x = x;
-                maze->start.y = y;
-                startCount++;
+// 㿽ʽʹöļgridֱָӳе
+static bool MazeAttachBinary(Maze* maze, MappedFile* mf) {
+    if (mf->size < sizeof(MazeBinaryHeader)) {
+        TraceLog(LOG_ERROR, "ԹļС");
+        return false;
+    }
+    MazeBinaryHeader header;
+    memcpy(&header, mf->data, sizeof(header));
+    if (header.version != MAZE_BINARY_VERSION) {
+        TraceLog(LOG_ERROR, "Թļ汾֧֣ļ汾%uǰ汾%u", header.version, MAZE_BINARY_VERSION);
+        return false;
+    }
+    if (!MazeCheckSize(header.rows, header.cols)) return false;
+    size_t total = (size_t)header.rows * header.cols;
+    if (mf->size - sizeof(MazeBinaryHeader) < total) {
+        TraceLog(LOG_ERROR, "Թļݲ");
+        return false;
+    }
+
+    maze->rows = header.rows;
+    maze->cols = header.cols;
+    maze->grid = (signed char*)(mf->data + sizeof(MazeBinaryHeader));
+
+    // Уؿȡֵͳ/յ㣺8һ飬ȫΪ0~3ʱ
+    int startCount = 0, endCount = 0;
+    const signed char* cells = maze->grid;
+    size_t i = 0;
+    while (i < total) {
+        if (i + 8 <= total) {
+            unsigned long long word;
+            memcpy(&word, cells + i, sizeof(word));
+            if ((word & 0xFCFCFCFCFCFCFCFCULL) == 0) {
+                i += 8;
+                continue;
             }
-            else if (maze->grid[y][x] == CELL_END) {
-                maze->end.x = x;
-                maze->end.y = y;
-                endCount++;
+        }
+        size_t groupEnd = (i + 8 <= total) ? i + 8 : total;
+        for (; i < groupEnd; i++) {
+            if (!MazeRecordCell(maze, (int)i, cells[i], &startCount, &endCount)) {
+                maze->grid = NULL;
+                return false;
             }
         }
     }
-    fclose(file);
+    if (!MazeCheckEndpoints(startCount, endCount)) {
+        maze->grid = NULL;
+        return false;
+    }
 
-    // У/յ
-    if (startCount != 1) {
-        TraceLog(LOG_ERROR, "Թҽ1㣨ǰ%d", startCount);
+    // ļͷе/յһ
+    if (header.start.x != maze->start.x || header.start.y != maze->start.y ||
+        header.end.x != maze->end.x || header.end.y != maze->end.y) {
+        TraceLog(LOG_ERROR, "Թļͷ/յݲһ");
+        maze->grid = NULL;
         return false;
     }
-    if (endCount != 1) {
-        TraceLog(LOG_ERROR, "Թҽ1յ㣨ǰ%d", endCount);
+    return true;
+}
+
+bool MazeLoadFromFile(Maze* maze, const char* filename) {
+    // ͷһμص
+    MazeReleaseGrid(maze);
+    maze->rows = 0;
+    maze->cols = 0;
+
+    MappedFile* mf = (MappedFile*)malloc(sizeof(MappedFile));
+    if (mf == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣļӳ");
+        return false;
+    }
+    if (!MappedFileOpen(mf, filename)) {
+        TraceLog(LOG_ERROR, "޷Թļ: %s", filename);
+        free(mf);
+        return false;
+    }
+
+    bool ok;
+    bool binary = mf->size >= 4 && memcmp(mf->data, MAZE_BINARY_MAGIC, 4) == 0;
+    if (binary) {
+        // Ƹʽӳ䣬ֱӳ
+        ok = MazeAttachBinary(maze, mf);
+        if (ok) {
+            maze->mapping = mf;
+        }
+        else {
+            MappedFileClose(mf);
+            free(mf);
+        }
+    }
+    else {
+        // ıʽڴ󼴿ɽӳ
+        ok = MazeParseText(maze, mf->data, mf->size);
+        MappedFileClose(mf);
+        free(mf);
+    }
+    if (!ok) {
+        MazeReleaseGrid(maze);
+        maze->rows = 0;
+        maze->cols = 0;
         return false;
     }
 
-    TraceLog(LOG_INFO, "Թļسɹ: %d %d", maze->rows, maze->cols);
+    TraceLog(LOG_INFO, "Թļسɹ: %d %dУ%sʽ", maze->rows, maze->cols, binary ? "" : "ı");
     TraceLog(LOG_INFO, "꣺(%d, %d)  յ꣺(%d, %d)",
         maze->start.x, maze->start.y, maze->end.x, maze->end.y);
     return true;
-}
\ No newline at end of file
+}
+
+bool MazeSaveBinary(Maze* maze, const char* filename) {
+    if (maze == NULL || maze->grid == NULL) return false;
+
+    FILE* file = MazeFileOpen(filename, "wb");
+    if (file == NULL) {
+        TraceLog(LOG_ERROR, "޷дԹļ: %s", filename);
+        return false;
+    }
+
+    MazeBinaryHeader header;
+    memcpy(header.magic, MAZE_BINARY_MAGIC, 4);
+    header.version = MAZE_BINARY_VERSION;
+    header.rows = maze->rows;
+    header.cols = maze->cols;
+    header.start = maze->start;
+    header.end = maze->end;
+
+    size_t total = (size_t)maze->rows * maze->cols;
+    bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+        fwrite(maze->grid, 1, total, file) == total;
+    ok = (fclose(file) == 0) && ok;
+    if (!ok) {
+        TraceLog(LOG_ERROR, "дԹļʧ: %s", filename);
+        return false;
+    }
+
+    TraceLog(LOG_INFO, "ԹѱΪƸʽ: %s", filename);
+    return true;
+}
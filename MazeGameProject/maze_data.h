@@ -4,11 +4,29 @@
 
 #include "maze_config.h"
 
+// Թļļͷ֮rows*colsֽڵݣȣ
+#define MAZE_BINARY_MAGIC     "MZB1"
+constexpr unsigned int MAZE_BINARY_VERSION = 1;
+
+// Թļͷ32ֽڣʼλö룩
+typedef struct {
+    char magic[4];         // ̶ΪMAZE_BINARY_MAGIC
+    unsigned int version;  // ʽ汾
+    int rows;              // Թ
+    int cols;              // Թ
+    Point start;           // 
+    Point end;             // յ
+} MazeBinaryHeader;
+
 // ʼԹ
 Maze* MazeCreate();
 // ͷԹڴ
 void MazeDestroy(Maze* maze);
-// ļԹ
+// ·Թͷžδʼ
+bool MazeAllocate(Maze* maze, int rows, int cols);
+// ļԹԶʶıʽƸʽ
 bool MazeLoadFromFile(Maze* maze, const char* filename);
+// ΪԹļ
+bool MazeSaveBinary(Maze* maze, const char* filename);
 
 #endif // MAZE_DATA_H
\ No newline at end of file
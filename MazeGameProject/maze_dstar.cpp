@@ -0,0 +1,204 @@
+#include "maze_dstar.h"
+#include "maze_utils.h"
+#include <string.h>
+
+// ڽӷϡ¡ң
+static const int DSTAR_DX[4] = { 0, 0, -1, 1 };
+static const int DSTAR_DY[4] = { -1, 1, 0, 0 };
+
+// նеļֵκθӵļֵ
+static const long long DSTAR_KEY_INF = LLONG_MAX;
+
+DStarLite* DStarCreate(const Maze* maze, const int* costTable) {
+    DStarLite* d = (DStarLite*)calloc(1, sizeof(DStarLite));
+    if (d == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ滮ṹ");
+        return NULL;
+    }
+    d->rows = maze->rows;
+    d->cols = maze->cols;
+    d->cellCount = maze->rows * maze->cols;
+    d->costTable = costTable;
+    d->goal = -1;
+    d->minCost = INT_MAX;
+    for (int t = 0; t < CELL_TYPE_COUNT; t++) {
+        if (costTable[t] != COST_IMPASSABLE && costTable[t] < d->minCost) d->minCost = costTable[t];
+    }
+    if (d->minCost == INT_MAX) d->minCost = 0;
+    d->g = (int*)malloc((size_t)d->cellCount * sizeof(int));
+    d->rhs = (int*)malloc((size_t)d->cellCount * sizeof(int));
+    d->open = IndexedHeapCreate(d->cellCount);
+    if (d->g == NULL || d->rhs == NULL || d->open == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ滮%d %dУ", maze->rows, maze->cols);
+        DStarDestroy(d);
+        return NULL;
+    }
+    return d;
+}
+
+void DStarDestroy(DStarLite* d) {
+    if (d == NULL) return;
+    free(d->g);
+    free(d->rhs);
+    IndexedHeapDestroy(d->open);
+    free(d);
+}
+
+// abپСγɱ
+static int DStarHeuristic(const DStarLite* d, int a, int b) {
+    return (abs(a % d->cols - b % d->cols) + abs(a / d->cols - b / d->cols)) * d->minCost;
+}
+
+// ֵ[min(g,rhs)+h+km, min(g,rhs)]ֵΪһ64λ
+static long long DStarKey(const DStarLite* d, int s) {
+    int m = d->g[s] < d->rhs[s] ? d->g[s] : d->rhs[s];
+    if (m == INT_MAX) return DSTAR_KEY_INF - 1;
+    long long k1 = (long long)m + DStarHeuristic(d, d->start, s) + d->km;
+    return (k1 << 31) | (long long)m;
+}
+
+static int DStarCost(const DStarLite* d, const Maze* maze, int cell) {
+    return TerrainCost(d->costTable, (CellType)maze->grid[cell]);
+}
+
+// ¼rhsǷһµ
+static void DStarUpdateVertex(DStarLite* d, const Maze* maze, int u) {
+    if (u != d->goal) {
+        int best = INT_MAX;
+        if (DStarCost(d, maze, u) != COST_IMPASSABLE) {
+            int x = u % d->cols;
+            int y = u / d->cols;
+            for (int k = 0; k < 4; k++) {
+                int nx = x + DSTAR_DX[k];
+                int ny = y + DSTAR_DY[k];
+                if (nx < 0 || nx >= d->cols || ny < 0 || ny >= d->rows) continue;
+                int v = ny * d->cols + nx;
+                int cost = DStarCost(d, maze, v);
+                if (cost == COST_IMPASSABLE || d->g[v] == INT_MAX) continue;
+                if (d->g[v] + cost < best) best = d->g[v] + cost;
+            }
+        }
+        d->rhs[u] = best;
+    }
+
+    bool queued = d->open->pos[u] >= 0;
+    if (d->g[u] != d->rhs[u]) {
+        if (queued) IndexedHeapUpdate(d->open, u, DStarKey(d, u));
+        else IndexedHeapPush(d->open, u, DStarKey(d, u));
+        SearchStatsPush(&d->stats, d->open->size);
+    }
+    else if (queued) {
+        IndexedHeapRemove(d->open, u);
+    }
+}
+
+// uǰһuھӣ
+static void DStarUpdatePredecessors(DStarLite* d, const Maze* maze, int u) {
+    int x = u % d->cols;
+    int y = u / d->cols;
+    for (int k = 0; k < 4; k++) {
+        int nx = x + DSTAR_DX[k];
+        int ny = y + DSTAR_DY[k];
+        if (nx < 0 || nx >= d->cols || ny < 0 || ny >= d->rows) continue;
+        SearchStatsRelax(&d->stats);
+        DStarUpdateVertex(d, maze, ny * d->cols + nx);
+    }
+}
+
+void DStarReset(DStarLite* d, Point start, Point goal) {
+    for (int i = 0; i < d->cellCount; i++) {
+        d->g[i] = INT_MAX;
+        d->rhs[i] = INT_MAX;
+    }
+    IndexedHeapClear(d->open);
+    d->start = start.y * d->cols + start.x;
+    d->goal = goal.y * d->cols + goal.x;
+    d->last = d->start;
+    d->km = 0;
+    d->rhs[d->goal] = 0;
+    IndexedHeapPush(d->open, d->goal, DStarKey(d, d->goal));
+}
+
+void DStarSetStart(DStarLite* d, Point start) {
+    d->start = start.y * d->cols + start.x;
+    // ƶֵ½СۼƵkm
+    d->km += DStarHeuristic(d, d->last, d->start);
+    d->last = d->start;
+}
+
+void DStarSetCell(DStarLite* d, Maze* maze, int x, int y, CellType type) {
+    int v = y * d->cols + x;
+    maze->grid[v] = (signed char)type;
+    if (d->goal < 0) return;
+
+    // vĳɱˣvھӰ죻vǷͨҲrhs
+    DStarUpdateVertex(d, maze, v);
+    DStarUpdatePredecessors(d, maze, v);
+}
+
+bool DStarPlan(DStarLite* d, const Maze* maze) {
+    d->expanded = 0;
+#if MAZE_STATS
+    // ؿ޸ʱUpdateVertexļڱι滮
+    memset(&d->stats, 0, sizeof(SearchStats));
+#endif
+    if (d->goal < 0) return false;
+    for (;;) {
+        long long top = d->open->size > 0 ? d->open->key[d->open->heap[0]] : DSTAR_KEY_INF;
+        if (top >= DStarKey(d, d->start) && d->rhs[d->start] == d->g[d->start]) break;
+        if (d->open->size == 0) break;
+
+        int u = d->open->heap[0];
+        long long fresh = DStarKey(d, u);
+        d->expanded++;
+        SearchStatsPop(&d->stats);
+        if (top < fresh) {
+            // kmӺɼֵƫС¼ֵŶ
+            IndexedHeapUpdate(d->open, u, fresh);
+            SearchStatsPush(&d->stats, d->open->size);
+        }
+        else if (d->g[u] > d->rhs[u]) {
+            // һ£ɱͣȷg֪ͨǰ
+            d->g[u] = d->rhs[u];
+            IndexedHeapRemove(d->open, u);
+            DStarUpdatePredecessors(d, maze, u);
+        }
+        else {
+            // Ƿһ£ɱߣΪͬǰ¼
+            d->g[u] = INT_MAX;
+            DStarUpdateVertex(d, maze, u);
+            DStarUpdatePredecessors(d, maze, u);
+        }
+    }
+    return d->g[d->start] != INT_MAX;
+}
+
+int DStarPath(const DStarLite* d, const Maze* maze, int* cells, int maxLen) {
+    if (d->goal < 0 || d->g[d->start] == INT_MAX || maxLen < 1) return 0;
+    int len = 0;
+    int u = d->start;
+    cells[len++] = u;
+    // ÿ򡰽ɱ+gСھ
+    while (u != d->goal) {
+        int x = u % d->cols;
+        int y = u / d->cols;
+        int next = -1;
+        long long best = LLONG_MAX;
+        for (int k = 0; k < 4; k++) {
+            int nx = x + DSTAR_DX[k];
+            int ny = y + DSTAR_DY[k];
+            if (nx < 0 || nx >= d->cols || ny < 0 || ny >= d->rows) continue;
+            int v = ny * d->cols + nx;
+            int cost = DStarCost(d, maze, v);
+            if (cost == COST_IMPASSABLE || d->g[v] == INT_MAX) continue;
+            if ((long long)d->g[v] + cost < best) {
+                best = (long long)d->g[v] + cost;
+                next = v;
+            }
+        }
+        if (next < 0 || len >= maxLen) return 0;
+        cells[len++] = next;
+        u = next;
+    }
+    return len;
+}
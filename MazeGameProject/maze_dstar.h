@@ -0,0 +1,45 @@
+#pragma once
+#ifndef MAZE_DSTAR_H
+#define MAZE_DSTAR_H
+
+#include "maze_config.h"
+#include "maze_queue.h"
+
+// 滮D* Liteյ㷴g/rhsڶι滮֮䱣
+// ؿ仯ֻ¼ɱӰĸӣƶֻƽƼֵkm
+// ع滮ĴӰԹȡյ仯ʱҪ³ʼ
+
+// 滮
+typedef struct DStarLite {
+    int rows;               // Թ
+    int cols;               // Թ
+    int cellCount;          // 
+    const int* costTable;   // γɱ
+    int minCost;            // ͨеεСɱã
+    int start;              // ±
+    int goal;               // յ±꣨-1ʾδʼ
+    int last;               // ϴۼkmʱ
+    long long km;           // ƶۼƵļֵƫ
+    int* g;                 // յĳɱINT_MAXʾ
+    int* rhs;               // ھƳһǰհɱ
+    IndexedHeap* open;      // һ¸ӵȶ
+    int expanded;           // һι滮ĸ
+    SearchStats stats;      // һι滮ͳƣӺŶӣΪĶ׸ӣɳΪµǰ
+} DStarLite;
+
+// 滮Թߴ䣩
+DStarLite* DStarCreate(const Maze* maze, const int* costTable);
+// ͷ滮
+void DStarDestroy(DStarLite* d);
+// ³ʼȫ״̬յʱʹã
+void DStarReset(DStarLite* d, Point start, Point goal);
+// ƶ㣨״̬
+void DStarSetStart(DStarLite* d, Point start);
+// ޸ĵؿ鲢Ӱĸӣ´ι滮ʱ޸
+void DStarSetCell(DStarLite* d, Maze* maze, int x, int y, CellType type);
+// 滮ǰ·ֻһµĸӣǷɴ
+bool DStarPlan(DStarLite* d, const Maze* maze);
+// 㵽յдһι滮·±꣨·ʧܷ0
+int DStarPath(const DStarLite* d, const Maze* maze, int* cells, int maxLen);
+
+#endif // MAZE_DSTAR_H
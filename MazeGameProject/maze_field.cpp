@@ -0,0 +1,124 @@
+#include "maze_field.h"
+#include "maze_utils.h"
+#include <string.h>
+
+// ڽӷϡ¡ңFieldDirectionһ£d^1Ϊ
+static const int FIELD_DX[4] = { 0, 0, -1, 1 };
+static const int FIELD_DY[4] = { -1, 1, 0, 0 };
+
+DistanceField* DistanceFieldCreate(const Maze* maze) {
+    DistanceField* field = (DistanceField*)calloc(1, sizeof(DistanceField));
+    if (field == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ볡ṹ");
+        return NULL;
+    }
+    size_t total = (size_t)maze->rows * maze->cols;
+    field->rows = maze->rows;
+    field->cols = maze->cols;
+    field->target = -1;
+    field->dirty = true;
+    field->distance = (int*)malloc(total * sizeof(int));
+    field->nextDir = (unsigned char*)malloc(total);
+    if (field->distance == NULL || field->nextDir == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ볡%d %dУ", maze->rows, maze->cols);
+        DistanceFieldDestroy(field);
+        return NULL;
+    }
+    return field;
+}
+
+void DistanceFieldDestroy(DistanceField* field) {
+    if (field == NULL) return;
+    free(field->distance);
+    free(field->nextDir);
+    BucketQueueDestroy(field->queue);
+    free(field);
+}
+
+void DistanceFieldInvalidate(DistanceField* field) {
+    field->dirty = true;
+}
+
+// DijkstraĿvĳɱΪvߵĿꡱĽɱ֮
+static bool DistanceFieldRebuild(DistanceField* field, const Maze* maze, int target, const int* costTable) {
+    int total = field->rows * field->cols;
+    int maxCost = 1;
+    for (int t = 0; t < CELL_TYPE_COUNT; t++) {
+        if (costTable[t] > maxCost) maxCost = costTable[t];
+    }
+    if (field->queue == NULL || field->queueMaxCost < maxCost) {
+        BucketQueueDestroy(field->queue);
+        field->queue = BucketQueueCreate(total, maxCost);
+        field->queueMaxCost = field->queue != NULL ? maxCost : 0;
+        if (field->queue == NULL) return false;
+    }
+    BucketQueueClear(field->queue);
+
+    for (int i = 0; i < total; i++) {
+        field->distance[i] = INT_MAX;
+    }
+    memset(field->nextDir, FIELD_NONE, (size_t)total);
+    field->reachable = 0;
+
+    field->distance[target] = 0;
+    BucketQueuePush(field->queue, target, 0);
+    while (field->queue->size > 0) {
+        int u = BucketQueuePop(field->queue);
+        field->reachable++;
+
+        // ھvһuĳɱuĵγɱ
+        int ux = u % field->cols;
+        int uy = u / field->cols;
+        int nd = field->distance[u] + TerrainCost(costTable, (CellType)maze->grid[u]);
+        for (int d = 0; d < 4; d++) {
+            int vx = ux + FIELD_DX[d];
+            int vy = uy + FIELD_DY[d];
+            if (vx < 0 || vx >= field->cols || vy < 0 || vy >= field->rows) continue;
+            int v = vy * field->cols + vx;
+            if (TerrainCost(costTable, (CellType)maze->grid[v]) == COST_IMPASSABLE) continue;
+            if (nd < field->distance[v]) {
+                field->distance[v] = nd;
+                field->nextDir[v] = (unsigned char)(d ^ 1); // vصuķ
+                BucketQueuePush(field->queue, v, nd);
+            }
+        }
+    }
+    field->rebuildCount++;
+    return true;
+}
+
+bool DistanceFieldUpdate(DistanceField* field, const Maze* maze, Point target, const int* costTable) {
+    if (maze->rows != field->rows || maze->cols != field->cols) {
+        TraceLog(LOG_ERROR, "볡ߴԹһ£%d %dУ", maze->rows, maze->cols);
+        return false;
+    }
+    if (target.x < 0 || target.x >= field->cols || target.y < 0 || target.y >= field->rows) return false;
+    int index = target.y * field->cols + target.x;
+    if (TerrainCost(costTable, (CellType)maze->grid[index]) == COST_IMPASSABLE) return false;
+
+    // Ŀδƶδ޸ʱֱӸ
+    if (!field->dirty && index == field->target && costTable == field->costTable) return true;
+
+    if (!DistanceFieldRebuild(field, maze, index, costTable)) {
+        TraceLog(LOG_ERROR, "ڴʧܣ볡Ͱ");
+        field->target = -1;
+        return false;
+    }
+    field->target = index;
+    field->costTable = costTable;
+    field->dirty = false;
+    return true;
+}
+
+int DistanceFieldCost(const DistanceField* field, Point p) {
+    if (field->target < 0 || p.x < 0 || p.x >= field->cols || p.y < 0 || p.y >= field->rows) return INT_MAX;
+    return field->distance[p.y * field->cols + p.x];
+}
+
+Point DistanceFieldNextStep(const DistanceField* field, Point p) {
+    if (field->target < 0 || p.x < 0 || p.x >= field->cols || p.y < 0 || p.y >= field->rows) return p;
+    int d = field->nextDir[p.y * field->cols + p.x];
+    if (d == FIELD_NONE) return p;
+    Point next = { p.x + FIELD_DX[d], p.y + FIELD_DY[d] };
+    return next;
+}
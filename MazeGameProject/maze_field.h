@@ -0,0 +1,49 @@
+#pragma once
+#ifndef MAZE_FIELD_H
+#define MAZE_FIELD_H
+
+#include "maze_config.h"
+#include "maze_queue.h"
+
+// 볡ĿһηDijkstraõÿӵĿСɱһ
+// Ŀ겻δʱֱӸãĵ˸O(1)ƶ
+// ޹أÿO(V + C)CΪ󵥲ɱ
+
+// һѰ·㷨ڽ˳һ£
+typedef enum {
+    FIELD_UP = 0,
+    FIELD_DOWN,
+    FIELD_LEFT,
+    FIELD_RIGHT,
+    FIELD_NONE        // Ŀ޷
+} FieldDirection;
+
+// 볡
+typedef struct {
+    int rows;                 // Թ
+    int cols;                 // Թ
+    int target;               // Ŀ±꣨-1ʾδ㣩
+    bool dirty;               // ޸ģ´θʱ
+    const int* costTable;     // õĳɱ
+    int* distance;            // ÿĿСɱINT_MAXʾɴ
+    unsigned char* nextDir;   // ÿĿһFieldDirection
+    BucketQueue* queue;       // DijkstraͰ
+    int queueMaxCost;         // Ͱֵ֧󵥲ɱ
+    int reachable;            // ɵĿĸ
+    int rebuildCount;         // ۼ
+} DistanceField;
+
+// 볡Թߴ䣻Թߴ仯´
+DistanceField* DistanceFieldCreate(const Maze* maze);
+// ͷž볡
+void DistanceFieldDestroy(DistanceField* field);
+// ޸ģ޸ĵؿã´θʱ㣩
+void DistanceFieldInvalidate(DistanceField* field);
+// targetΪĿ¾볡Ŀꡢɱδδ޸ʱֱӷأĿ겻ͨʱfalse
+bool DistanceFieldUpdate(DistanceField* field, const Maze* maze, Point target, const int* costTable);
+// ѯӵĿСɱԽ򲻿ɴΪINT_MAX
+int DistanceFieldCost(const DistanceField* field, Point p);
+// ѯpĿһĿꡢԽ򲻿ɴʱp
+Point DistanceFieldNextStep(const DistanceField* field, Point p);
+
+#endif // MAZE_FIELD_H
@@ -0,0 +1,462 @@
+#include "maze_generate.h"
+#include "maze_data.h"
+#include "maze_utils.h"
+#include "maze_parallel.h"
+#include <string.h>
+
+// ĸң
+static const int DIR_DX[4] = { 0, 0, -1, 1 };
+static const int DIR_DY[4] = { -1, 1, 0, 0 };
+constexpr int DIR_DOWN = 1;
+constexpr int DIR_RIGHT = 3;
+
+// ֿ鲢ʱÿķ߳
+constexpr int GEN_TILE_ROOMS = 256;
+
+// ɹ̵Ĺݣ(rx, ry)Ӧ(2rx+1, 2ry+1)Ϊry*roomCols+rx
+typedef struct {
+    Maze* maze;
+    int roomCols;           // ÿз
+    int roomRows;           // ÿз
+    int tileW;              // ֿȣ
+    int tileH;              // ֿ߶ȣ
+    int tileCols;           // ֿ
+    int tileRows;           // ֿ
+    unsigned long long seed;
+    MazeGenerator algorithm;
+    int* parent;            // Kruskal鼯ڵ㣨ţ
+    int* edges;             // KruskalÿĺѡǽƬ
+    unsigned char* state;   // Prim״̬0δ룬1߽磬2Ѽ룩
+    int* frontier;          // Primÿı߽бƬ
+} GenContext;
+
+// һֿķ䷶Χҿ
+typedef struct {
+    int rx0, ry0, rx1, ry1;
+} GenTile;
+
+static GenTile GetTile(const GenContext* g, int tileIndex) {
+    GenTile t;
+    t.rx0 = (tileIndex % g->tileCols) * g->tileW;
+    t.ry0 = (tileIndex / g->tileCols) * g->tileH;
+    t.rx1 = t.rx0 + g->tileW < g->roomCols ? t.rx0 + g->tileW : g->roomCols;
+    t.ry1 = t.ry0 + g->tileH < g->roomRows ? t.ry0 + g->tileH : g->roomRows;
+    return t;
+}
+
+// ÿֿʹöУ߳޹
+static unsigned long long TileSeed(const GenContext* g, int tileIndex) {
+    unsigned long long state = g->seed ^ ((unsigned long long)(tileIndex + 1) * 0xD1B54A32D192ED03ULL);
+    return MazeRandom(&state);
+}
+
+static int RoomCell(const GenContext* g, int rx, int ry) {
+    return MazeIndex(g->maze, 2 * rx + 1, 2 * ry + 1);
+}
+
+// dirڷ֮ǽ
+static int WallCell(const GenContext* g, int rx, int ry, int dir) {
+    return MazeIndex(g->maze, 2 * rx + 1 + DIR_DX[dir], 2 * ry + 1 + DIR_DY[dir]);
+}
+
+static bool RoomOpen(const GenContext* g, int rx, int ry) {
+    return g->maze->grid[RoomCell(g, rx, ry)] != CELL_WALL;
+}
+
+static void CarveRoom(GenContext* g, int rx, int ry) {
+    g->maze->grid[RoomCell(g, rx, ry)] = CELL_GROUND;
+}
+
+static void CarveWall(GenContext* g, int rx, int ry, int dir) {
+    g->maze->grid[WallCell(g, rx, ry, dir)] = CELL_GROUND;
+}
+
+static bool InTile(const GenTile* t, int rx, int ry) {
+    return rx >= t->rx0 && rx < t->rx1 && ry >= t->ry0 && ry < t->ry1;
+}
+
+// ݹݣʽջݹ飬ÿһδʵڷ
+static bool GenerateBacktracker(GenContext* g) {
+    int roomCount = g->roomCols * g->roomRows;
+    int* stack = (int*)malloc((size_t)roomCount * sizeof(int));
+    if (stack == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣջ");
+        return false;
+    }
+
+    unsigned long long state = g->seed;
+    int top = 0;
+    stack[0] = MazeRandomBelow(&state, roomCount);
+    CarveRoom(g, stack[0] % g->roomCols, stack[0] / g->roomCols);
+    while (top >= 0) {
+        int rx = stack[top] % g->roomCols;
+        int ry = stack[top] / g->roomCols;
+        int options[4];
+        int n = 0;
+        for (int d = 0; d < 4; d++) {
+            int nx = rx + DIR_DX[d];
+            int ny = ry + DIR_DY[d];
+            if (nx >= 0 && nx < g->roomCols && ny >= 0 && ny < g->roomRows && !RoomOpen(g, nx, ny)) {
+                options[n++] = d;
+            }
+        }
+        if (n == 0) {
+            top--; // ·ߣ
+            continue;
+        }
+        int d = options[n == 1 ? 0 : MazeRandomBelow(&state, n)];
+        int nx = rx + DIR_DX[d];
+        int ny = ry + DIR_DY[d];
+        CarveWall(g, rx, ry, d);
+        CarveRoom(g, nx, ny);
+        stack[++top] = ny * g->roomCols + nx;
+    }
+
+    free(stack);
+    return true;
+}
+
+// 鼯ң·ѹ
+static int UnionFind(int* parent, int x) {
+    while (parent[x] != x) {
+        parent[x] = parent[parent[x]];
+        x = parent[x];
+    }
+    return x;
+}
+
+// Kruskalֿ飩ѡǽкδͨͬϵǽ
+static void GenerateKruskalTile(int tileIndex, void* context) {
+    GenContext* g = (GenContext*)context;
+    GenTile t = GetTile(g, tileIndex);
+    int* edges = g->edges + (size_t)tileIndex * 2 * g->tileW * g->tileH;
+    int cols = g->maze->cols;
+
+    // ռֿڲĺѡǽҡ£
+    int edgeCount = 0;
+    for (int ry = t.ry0; ry < t.ry1; ry++) {
+        for (int rx = t.rx0; rx < t.rx1; rx++) {
+            int r = ry * g->roomCols + rx;
+            g->parent[r] = r;
+            CarveRoom(g, rx, ry);
+            if (rx + 1 < t.rx1) edges[edgeCount++] = WallCell(g, rx, ry, DIR_RIGHT);
+            if (ry + 1 < t.ry1) edges[edgeCount++] = WallCell(g, rx, ry, DIR_DOWN);
+        }
+    }
+
+    // Fisher-Yatesϴ
+    unsigned long long state = TileSeed(g, tileIndex);
+    for (int i = edgeCount - 1; i > 0; i--) {
+        int j = MazeRandomBelow(&state, i + 1);
+        int tmp = edges[i];
+        edges[i] = edges[j];
+        edges[j] = tmp;
+    }
+
+    // nֻn-1ǽͨ
+    int remaining = (t.rx1 - t.rx0) * (t.ry1 - t.ry0) - 1;
+    for (int i = 0; i < edgeCount && remaining > 0; i++) {
+        int wx = edges[i] % cols;
+        int wy = edges[i] / cols;
+        // żеǽ䣬
+        int a, b;
+        if (wx % 2 == 0) {
+            a = ((wy - 1) / 2) * g->roomCols + (wx - 2) / 2;
+            b = a + 1;
+        }
+        else {
+            a = ((wy - 2) / 2) * g->roomCols + (wx - 1) / 2;
+            b = a + g->roomCols;
+        }
+        int ra = UnionFind(g->parent, a);
+        int rb = UnionFind(g->parent, b);
+        if (ra == rb) continue;
+        g->parent[ra] = rb;
+        g->maze->grid[edges[i]] = CELL_GROUND;
+        remaining--;
+    }
+}
+
+// ѷֿδڷ߽б
+static void PrimAddFrontier(GenContext* g, const GenTile* t, int* frontier, int* count, int rx, int ry) {
+    for (int d = 0; d < 4; d++) {
+        int nx = rx + DIR_DX[d];
+        int ny = ry + DIR_DY[d];
+        if (!InTile(t, nx, ny)) continue;
+        int r = ny * g->roomCols + nx;
+        if (g->state[r] != 0) continue;
+        g->state[r] = 1;
+        frontier[(*count)++] = r;
+    }
+}
+
+// Primֿ飩ȡһ߽緿䣬һѼڷ
+static void GeneratePrimTile(int tileIndex, void* context) {
+    GenContext* g = (GenContext*)context;
+    GenTile t = GetTile(g, tileIndex);
+    int* frontier = g->frontier + (size_t)tileIndex * g->tileW * g->tileH;
+    int count = 0;
+
+    unsigned long long state = TileSeed(g, tileIndex);
+    int rx = t.rx0 + MazeRandomBelow(&state, t.rx1 - t.rx0);
+    int ry = t.ry0 + MazeRandomBelow(&state, t.ry1 - t.ry0);
+    g->state[ry * g->roomCols + rx] = 2;
+    CarveRoom(g, rx, ry);
+    PrimAddFrontier(g, &t, frontier, &count, rx, ry);
+
+    while (count > 0) {
+        int i = MazeRandomBelow(&state, count);
+        int r = frontier[i];
+        frontier[i] = frontier[--count];
+        rx = r % g->roomCols;
+        ry = r / g->roomCols;
+
+        int options[4];
+        int n = 0;
+        for (int d = 0; d < 4; d++) {
+            int nx = rx + DIR_DX[d];
+            int ny = ry + DIR_DY[d];
+            if (InTile(&t, nx, ny) && g->state[ny * g->roomCols + nx] == 2) options[n++] = d;
+        }
+        CarveWall(g, rx, ry, options[n == 1 ? 0 : MazeRandomBelow(&state, n)]);
+        CarveRoom(g, rx, ry);
+        g->state[r] = 2;
+        PrimAddFrontier(g, &t, frontier, &count, rx, ry);
+    }
+}
+
+// ѸֿÿĽͨһǽԹ
+static bool ConnectTiles(GenContext* g) {
+    int tileCount = g->tileCols * g->tileRows;
+    int* parent = (int*)malloc((size_t)tileCount * sizeof(int));
+    int* links = (int*)malloc((size_t)tileCount * 2 * sizeof(int));
+    if (parent == NULL || links == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣֿ");
+        free(parent);
+        free(links);
+        return false;
+    }
+
+    // ѡӱţtile*2+0ΪҲֿtile*2+1Ϊ·ֿ
+    int linkCount = 0;
+    for (int i = 0; i < tileCount; i++) {
+        parent[i] = i;
+        if (i % g->tileCols + 1 < g->tileCols) links[linkCount++] = i * 2;
+        if (i / g->tileCols + 1 < g->tileRows) links[linkCount++] = i * 2 + 1;
+    }
+    unsigned long long state = TileSeed(g, tileCount);
+    for (int i = linkCount - 1; i > 0; i--) {
+        int j = MazeRandomBelow(&state, i + 1);
+        int tmp = links[i];
+        links[i] = links[j];
+        links[j] = tmp;
+    }
+
+    for (int i = 0; i < linkCount; i++) {
+        int a = links[i] / 2;
+        bool down = (links[i] % 2) == 1;
+        int b = down ? a + g->tileCols : a + 1;
+        int ra = UnionFind(parent, a);
+        int rb = UnionFind(parent, b);
+        if (ra == rb) continue;
+        parent[ra] = rb;
+
+        GenTile t = GetTile(g, a);
+        if (down) CarveWall(g, t.rx0 + MazeRandomBelow(&state, t.rx1 - t.rx0), t.ry1 - 1, DIR_DOWN);
+        else CarveWall(g, t.rx1 - 1, t.ry0 + MazeRandomBelow(&state, t.ry1 - t.ry0), DIR_RIGHT);
+    }
+
+    free(parent);
+    free(links);
+    return true;
+}
+
+// Kruskal/PrimֿɣɲУٰѷֿһСԹֻһ飩
+static bool GenerateTiled(GenContext* g, int threads) {
+    int tileCount = g->tileCols * g->tileRows;
+    size_t tileRooms = (size_t)g->tileW * g->tileH;
+    bool kruskal = (g->algorithm == GEN_KRUSKAL);
+    if (kruskal) {
+        g->parent = (int*)malloc((size_t)g->roomCols * g->roomRows * sizeof(int));
+        g->edges = (int*)malloc((size_t)tileCount * 2 * tileRooms * sizeof(int));
+    }
+    else {
+        g->state = (unsigned char*)calloc((size_t)g->roomCols * g->roomRows, 1);
+        g->frontier = (int*)malloc((size_t)tileCount * tileRooms * sizeof(int));
+    }
+
+    bool ok = kruskal ? (g->parent != NULL && g->edges != NULL) : (g->state != NULL && g->frontier != NULL);
+    if (!ok) {
+        TraceLog(LOG_ERROR, "ڴʧܣ%sɻ", MazeGeneratorName(g->algorithm));
+    }
+    else {
+        ParallelFor(tileCount, threads, kruskal ? GenerateKruskalTile : GeneratePrimTile, g);
+        if (tileCount > 1) ok = ConnectTiles(g);
+    }
+
+    free(g->parent);
+    free(g->edges);
+    free(g->state);
+    free(g->frontier);
+    return ok;
+}
+
+// Wilsonδķߣֻ¼ÿ뿪ķ൱ڲ
+// Ѽķؼ¼ķ·Թ
+static bool GenerateWilson(GenContext* g) {
+    int roomCount = g->roomCols * g->roomRows;
+    unsigned char* dirs = (unsigned char*)malloc((size_t)roomCount);
+    if (dirs == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ߷");
+        return false;
+    }
+
+    unsigned long long state = g->seed;
+    int first = MazeRandomBelow(&state, roomCount);
+    CarveRoom(g, first % g->roomCols, first / g->roomCols);
+    for (int r = 0; r < roomCount; r++) {
+        int rx = r % g->roomCols;
+        int ry = r / g->roomCols;
+        if (RoomOpen(g, rx, ry)) continue;
+
+        // ֱԹ
+        int x = rx, y = ry;
+        while (!RoomOpen(g, x, y)) {
+            int d, nx, ny;
+            do {
+                d = MazeRandomBelow(&state, 4);
+                nx = x + DIR_DX[d];
+                ny = y + DIR_DY[d];
+            } while (nx < 0 || nx >= g->roomCols || ny < 0 || ny >= g->roomRows);
+            dirs[y * g->roomCols + x] = (unsigned char)d;
+            x = nx;
+            y = ny;
+        }
+
+        // ؼ¼ķԹ
+        x = rx;
+        y = ry;
+        while (!RoomOpen(g, x, y)) {
+            int d = dirs[y * g->roomCols + x];
+            CarveRoom(g, x, y);
+            CarveWall(g, x, y, d);
+            x += DIR_DX[d];
+            y += DIR_DY[d];
+        }
+    }
+
+    free(dirs);
+    return true;
+}
+
+// ͨ·ֻһ濪ڵķ䣬ٴͨһǽ
+static void BraidMaze(GenContext* g, double braid, unsigned long long* state) {
+    for (int ry = 0; ry < g->roomRows; ry++) {
+        for (int rx = 0; rx < g->roomCols; rx++) {
+            int closed[4];
+            int closedCount = 0;
+            int openCount = 0;
+            for (int d = 0; d < 4; d++) {
+                int nx = rx + DIR_DX[d];
+                int ny = ry + DIR_DY[d];
+                if (nx < 0 || nx >= g->roomCols || ny < 0 || ny >= g->roomRows) continue;
+                if (g->maze->grid[WallCell(g, rx, ry, d)] == CELL_WALL) closed[closedCount++] = d;
+                else openCount++;
+            }
+            if (openCount != 1 || closedCount == 0 || MazeRandomUnit(state) >= braid) continue;
+            CarveWall(g, rx, ry, closed[MazeRandomBelow(state, closedCount)]);
+        }
+    }
+}
+
+// ͨ滻Ϊݵ/
+static void SprinkleTerrain(Maze* maze, double grassRatio, double lavaRatio, unsigned long long* state) {
+    size_t total = (size_t)maze->rows * maze->cols;
+    double lavaEdge = grassRatio + lavaRatio;
+    for (size_t i = 0; i < total; i++) {
+        if (maze->grid[i] == CELL_WALL) continue;
+        double r = MazeRandomUnit(state);
+        if (r < grassRatio) maze->grid[i] = CELL_GRASS;
+        else if (r < lavaEdge) maze->grid[i] = CELL_LAVA;
+    }
+}
+
+void MazeGenOptionsDefault(MazeGenOptions* opt, int rows, int cols, unsigned long long seed) {
+    opt->algorithm = GEN_BACKTRACKER;
+    opt->rows = rows;
+    opt->cols = cols;
+    opt->seed = seed;
+    opt->braid = 0.0;
+    opt->grassRatio = 0.0;
+    opt->lavaRatio = 0.0;
+    opt->threads = 1;
+}
+
+bool MazeGenerate(Maze* maze, const MazeGenOptions* opt) {
+    if (opt->algorithm < 0 || opt->algorithm >= GEN_COUNT) {
+        TraceLog(LOG_ERROR, "Թ㷨Ƿ%d", (int)opt->algorithm);
+        return false;
+    }
+    if (opt->rows < 3 || opt->cols < 3) {
+        TraceLog(LOG_ERROR, "ԹΪ3ǰ%d %dУ", opt->rows, opt->cols);
+        return false;
+    }
+    if (opt->braid < 0.0 || opt->braid > 1.0 || opt->grassRatio < 0.0 || opt->lavaRatio < 0.0 ||
+        opt->grassRatio + opt->lavaRatio > 1.0) {
+        TraceLog(LOG_ERROR, "ԹɲǷ0~1֮䣩");
+        return false;
+    }
+    if (!MazeAllocate(maze, opt->rows, opt->cols)) return false;
+    memset(maze->grid, CELL_WALL, (size_t)opt->rows * opt->cols);
+
+    GenContext g;
+    memset(&g, 0, sizeof(g));
+    g.maze = maze;
+    g.roomCols = (opt->cols - 1) / 2;
+    g.roomRows = (opt->rows - 1) / 2;
+    g.seed = opt->seed;
+    g.algorithm = opt->algorithm;
+    // Kruskal/PrimڴԹϷֿɣʾڿڣѺãֻֿȡڳߴ磬߳޹
+    bool tiled = (opt->algorithm == GEN_KRUSKAL || opt->algorithm == GEN_PRIM);
+    int threads = tiled ? ParallelThreadCount(opt->threads) : 1;
+    g.tileW = (tiled && g.roomCols > GEN_TILE_ROOMS) ? GEN_TILE_ROOMS : g.roomCols;
+    g.tileH = (tiled && g.roomRows > GEN_TILE_ROOMS) ? GEN_TILE_ROOMS : g.roomRows;
+    g.tileCols = (g.roomCols + g.tileW - 1) / g.tileW;
+    g.tileRows = (g.roomRows + g.tileH - 1) / g.tileH;
+
+    bool ok;
+    switch (opt->algorithm) {
+    case GEN_BACKTRACKER: ok = GenerateBacktracker(&g); break;
+    case GEN_WILSON:      ok = GenerateWilson(&g); break;
+    default:              ok = GenerateTiled(&g, threads); break;
+    }
+    if (!ok) {
+        free(maze->grid);
+        maze->grid = NULL;
+        maze->rows = 0;
+        maze->cols = 0;
+        return false;
+    }
+
+    // ʹöУ㷨ٵӰ
+    unsigned long long state = opt->seed ^ 0xA0761D6478BD642FULL;
+    if (opt->braid > 0.0) BraidMaze(&g, opt->braid, &state);
+    if (opt->grassRatio > 0.0 || opt->lavaRatio > 0.0) SprinkleTerrain(maze, opt->grassRatio, opt->lavaRatio, &state);
+
+    maze->start.x = 1;
+    maze->start.y = 1;
+    maze->end.x = 2 * g.roomCols - 1;
+    maze->end.y = 2 * g.roomRows - 1;
+    maze->grid[MazeIndex(maze, maze->start.x, maze->start.y)] = CELL_START;
+    maze->grid[MazeIndex(maze, maze->end.x, maze->end.y)] = CELL_END;
+
+    TraceLog(LOG_INFO, "Թɣ%s %d %dУ%ḍ߳", MazeGeneratorName(opt->algorithm),
+        opt->rows, opt->cols, threads);
+    return true;
+}
+
+const char* MazeGeneratorName(MazeGenerator algorithm) {
+    static const char* names[GEN_COUNT] = { "Backtracker", "Kruskal", "Prim", "Wilson" };
+    if (algorithm < 0 || algorithm >= GEN_COUNT) return "UNKNOWN";
+    return names[algorithm];
+}
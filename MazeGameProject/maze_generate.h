@@ -0,0 +1,38 @@
+#pragma once
+#ifndef MAZE_GENERATE_H
+#define MAZE_GENERATE_H
+
+#include "maze_config.h"
+
+// Թ㷨
+typedef enum {
+    GEN_BACKTRACKER = 0,  // ݹݣʽջʵ֣ȡֲ٣
+    GEN_KRUSKAL,          // Kruskal·ѹ鼯
+    GEN_PRIM,             // Prim·ࣩ
+    GEN_WILSON,           // Wilsonߣ
+    GEN_COUNT
+} MazeGenerator;
+
+// Թɲ
+// ĸΪ䣬żΪǽΪżʱһ/бΪǽ
+// Kruskal/Primڳ256x256ʱֿɣԹ
+// ̶ϽǷ䣬յ̶½Ƿ䡣
+typedef struct {
+    MazeGenerator algorithm;  // 㷨
+    int rows;                 // 3
+    int cols;                 // 3
+    unsigned long long seed;  // ӣͬͬԹ
+    double braid;             // ͨ·ı0~10ΪԹ>0ʱֶ·ߣ
+    double grassRatio;        // ͨӱΪݵصı
+    double lavaRatio;         // ͨӱΪҵı
+    int threads;              // Kruskal/Primֿɵ߳<=0ΪȫӲ̣߳߳޹أ
+} MazeGenOptions;
+
+// Ĭɲ̻߳ݡԹ޲ݵң
+void MazeGenOptionsDefault(MazeGenOptions* opt, int rows, int cols, unsigned long long seed);
+// Թֱдmaze滻ԭ
+bool MazeGenerate(Maze* maze, const MazeGenOptions* opt);
+// ȡ㷨
+const char* MazeGeneratorName(MazeGenerator algorithm);
+
+#endif // MAZE_GENERATE_H
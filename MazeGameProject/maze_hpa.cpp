@@ -0,0 +1,639 @@
+#include "maze_hpa.h"
+#include "maze_utils.h"
+#include "maze_parallel.h"
+#include <atomic>
+#include <string.h>
+
+// ڽӷϡ¡ң
+static const int HPA_DX[4] = { 0, 0, -1, 1 };
+static const int HPA_DY[4] = { -1, 1, 0, 0 };
+
+// ص䣬ÿ߳һ
+typedef struct HpaLocal {
+    int* dist;          // ڸĳɱ±꣩
+    int* parent;        // ڸڵ㣨±꣬-1ʾޣ
+    IndexedHeap* heap;
+    int* entrances;     // ռõʱ飨Ϊܳ
+    int* edgeTo;        // ʱʱߣΪƽ
+    int* edgeCost;
+    int edgeCapacity;
+} HpaLocal;
+
+static HpaLocal* HpaLocalCreate(int clusterSize) {
+    HpaLocal* local = (HpaLocal*)calloc(1, sizeof(HpaLocal));
+    if (local == NULL) return NULL;
+    int cells = clusterSize * clusterSize;
+    local->dist = (int*)malloc((size_t)cells * sizeof(int));
+    local->parent = (int*)malloc((size_t)cells * sizeof(int));
+    local->heap = IndexedHeapCreate(cells);
+    local->entrances = (int*)malloc((size_t)clusterSize * 4 * sizeof(int));
+    if (local->dist == NULL || local->parent == NULL || local->heap == NULL || local->entrances == NULL) {
+        free(local->dist);
+        free(local->parent);
+        IndexedHeapDestroy(local->heap);
+        free(local->entrances);
+        free(local);
+        return NULL;
+    }
+    return local;
+}
+
+static void HpaLocalDestroy(HpaLocal* local) {
+    if (local == NULL) return;
+    free(local->dist);
+    free(local->parent);
+    IndexedHeapDestroy(local->heap);
+    free(local->entrances);
+    free(local->edgeTo);
+    free(local->edgeCost);
+    free(local);
+}
+
+static int HpaCellCost(const HpaGraph* g, const Maze* maze, int cell) {
+    return TerrainCost(g->costTable, (CellType)maze->grid[cell]);
+}
+
+static int HpaClusterOf(const HpaGraph* g, int cell) {
+    int x = cell % g->cols;
+    int y = cell / g->cols;
+    return (y / g->clusterSize) * g->clusterCols + x / g->clusterSize;
+}
+
+// ±ת±
+static int HpaLocalIndex(const HpaCluster* c, int cols, int cell) {
+    return (cell / cols - c->y0) * c->width + cell % cols - c->x0;
+}
+
+// Dijkstraֻڴصľչ
+// reverseΪfalseʱdistΪsourceĳɱΪtrueʱΪsourceĳɱtarget>=0ʱȷtargetֹͣ
+static void HpaLocalSearch(const HpaGraph* g, const Maze* maze, const HpaCluster* c, HpaLocal* local, int source, int target, bool reverse) {
+    int cells = c->width * c->height;
+    for (int i = 0; i < cells; i++) {
+        local->dist[i] = INT_MAX;
+    }
+    IndexedHeapClear(local->heap);
+
+    int s = HpaLocalIndex(c, g->cols, source);
+    int t = target >= 0 ? HpaLocalIndex(c, g->cols, target) : -1;
+    local->dist[s] = 0;
+    local->parent[s] = -1;
+    IndexedHeapPush(local->heap, s, 0);
+    while (local->heap->size > 0) {
+        int u = IndexedHeapPop(local->heap);
+        if (u == t) break;
+        int ux = u % c->width;
+        int uy = u / c->width;
+        int du = local->dist[u];
+        int leave = reverse ? HpaCellCost(g, maze, (c->y0 + uy) * g->cols + c->x0 + ux) : 0;
+        for (int d = 0; d < 4; d++) {
+            int vx = ux + HPA_DX[d];
+            int vy = uy + HPA_DY[d];
+            if (vx < 0 || vx >= c->width || vy < 0 || vy >= c->height) continue;
+            int cost = HpaCellCost(g, maze, (c->y0 + vy) * g->cols + c->x0 + vx);
+            if (cost == COST_IMPASSABLE) continue;
+            // 򣺽vĳɱ򣺴vuĳɱ
+            int nd = du + (reverse ? leave : cost);
+            int v = vy * c->width + vx;
+            if (nd < local->dist[v]) {
+                local->dist[v] = nd;
+                local->parent[v] = u;
+                IndexedHeapPush(local->heap, v, nd);
+            }
+        }
+    }
+}
+
+// ɨһر߽磺(x, y)(stepX, stepY)length񣬶Բƫ(crossX, crossY)
+// ඼ͨеΰѡһڣֻ¼ӣ
+static void HpaScanBorder(const HpaGraph* g, const Maze* maze, int x, int y, int stepX, int stepY,
+    int crossX, int crossY, int length, int* out, int* count) {
+    int runStart = -1;
+    for (int k = 0; k <= length; k++) {
+        bool open = false;
+        if (k < length) {
+            int a = (y + k * stepY) * g->cols + x + k * stepX;
+            int b = a + crossY * g->cols + crossX;
+            open = HpaCellCost(g, maze, a) != COST_IMPASSABLE && HpaCellCost(g, maze, b) != COST_IMPASSABLE;
+        }
+        if (open && runStart < 0) runStart = k;
+        if (open || runStart < 0) continue;
+
+        int runLength = k - runStart;
+        int picks[2] = { runStart + runLength / 2, -1 };
+        if (runLength >= HPA_SPLIT_LENGTH) {
+            picks[0] = runStart;
+            picks[1] = k - 1;
+        }
+        for (int p = 0; p < 2 && picks[p] >= 0; p++) {
+            out[(*count)++] = (y + picks[p] * stepY) * g->cols + x + picks[p] * stepX;
+        }
+        runStart = -1;
+    }
+}
+
+static void HpaClusterRelease(HpaCluster* c) {
+    free(c->nodeCell);
+    free(c->edgeStart);
+    free(c->edgeTo);
+    free(c->edgeCost);
+    c->nodeCell = NULL;
+    c->edgeStart = NULL;
+    c->edgeTo = NULL;
+    c->edgeCost = NULL;
+    c->nodeCount = 0;
+}
+
+// ؽأռϵڣٴÿһδõڵĳɱ
+static bool HpaBuildCluster(HpaGraph* g, const Maze* maze, int index, HpaLocal* local) {
+    HpaCluster* c = &g->clusters[index];
+    HpaClusterRelease(c);
+
+    int count = 0;
+    int* found = local->entrances;
+    int right = c->x0 + c->width - 1;
+    int bottom = c->y0 + c->height - 1;
+    if (c->y0 > 0) HpaScanBorder(g, maze, c->x0, c->y0, 1, 0, 0, -1, c->width, found, &count);
+    if (bottom < g->rows - 1) HpaScanBorder(g, maze, c->x0, bottom, 1, 0, 0, 1, c->width, found, &count);
+    if (c->x0 > 0) HpaScanBorder(g, maze, c->x0, c->y0, 0, 1, -1, 0, c->height, found, &count);
+    if (right < g->cols - 1) HpaScanBorder(g, maze, right, c->y0, 0, 1, 1, 0, c->height, found, &count);
+
+    // ȥأϵĸӿͬʱߵڣ
+    for (int i = 1; i < count; i++) {
+        int v = found[i];
+        int j = i;
+        while (j > 0 && found[j - 1] > v) {
+            found[j] = found[j - 1];
+            j--;
+        }
+        found[j] = v;
+    }
+    int unique = 0;
+    for (int i = 0; i < count; i++) {
+        if (unique == 0 || found[unique - 1] != found[i]) found[unique++] = found[i];
+    }
+    count = unique;
+
+    c->nodeCell = (int*)malloc((size_t)(count > 0 ? count : 1) * sizeof(int));
+    c->edgeStart = (int*)malloc((size_t)(count + 1) * sizeof(int));
+    int maxEdges = count * (count - 1);
+    if (maxEdges > local->edgeCapacity) {
+        free(local->edgeTo);
+        free(local->edgeCost);
+        local->edgeTo = (int*)malloc((size_t)maxEdges * sizeof(int));
+        local->edgeCost = (int*)malloc((size_t)maxEdges * sizeof(int));
+        local->edgeCapacity = (local->edgeTo != NULL && local->edgeCost != NULL) ? maxEdges : 0;
+    }
+    if (c->nodeCell == NULL || c->edgeStart == NULL || (maxEdges > 0 && local->edgeCapacity == 0)) {
+        HpaClusterRelease(c);
+        return false;
+    }
+    memcpy(c->nodeCell, found, (size_t)count * sizeof(int));
+    c->nodeCount = count;
+
+    int edges = 0;
+    for (int i = 0; i < count; i++) {
+        c->edgeStart[i] = edges;
+        HpaLocalSearch(g, maze, c, local, c->nodeCell[i], -1, false);
+        for (int j = 0; j < count; j++) {
+            int d = local->dist[HpaLocalIndex(c, g->cols, c->nodeCell[j])];
+            if (j == i || d == INT_MAX) continue;
+            local->edgeTo[edges] = j;
+            local->edgeCost[edges] = d;
+            edges++;
+        }
+    }
+    c->edgeStart[count] = edges;
+    c->edgeTo = (int*)malloc((size_t)(edges > 0 ? edges : 1) * sizeof(int));
+    c->edgeCost = (int*)malloc((size_t)(edges > 0 ? edges : 1) * sizeof(int));
+    if (c->edgeTo == NULL || c->edgeCost == NULL) {
+        HpaClusterRelease(c);
+        return false;
+    }
+    memcpy(c->edgeTo, local->edgeTo, (size_t)edges * sizeof(int));
+    memcpy(c->edgeCost, local->edgeCost, (size_t)edges * sizeof(int));
+    return true;
+}
+
+// ¼ڵȫֱţػؽãѯʱ޸ķֲͼ
+static void HpaRenumber(HpaGraph* g) {
+    int total = 0;
+    int widest = 0;
+    for (int i = 0; i < g->clusterCount; i++) {
+        g->nodeBase[i] = total;
+        total += g->clusters[i].nodeCount;
+        if (g->clusters[i].nodeCount > widest) widest = g->clusters[i].nodeCount;
+    }
+    g->nodeBase[g->clusterCount] = total;
+    g->nodeTotal = total;
+    g->widestCluster = widest;
+}
+
+// нص
+typedef struct {
+    HpaGraph* graph;
+    const Maze* maze;
+    HpaLocal** locals;
+    std::atomic<int>* failed;
+} HpaBuildJob;
+
+static void HpaBuildTask(int index, int worker, void* context) {
+    HpaBuildJob* job = (HpaBuildJob*)context;
+    if (!HpaBuildCluster(job->graph, job->maze, index, job->locals[worker])) {
+        job->failed->fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+// ̳߳زнȫأÿ߳ʹԼĴڹ
+static bool HpaBuildAll(HpaGraph* g, const Maze* maze, int threads) {
+    ParallelPool* pool = ParallelPoolCreate(threads);
+    if (pool == NULL) return false;
+    int workers = ParallelPoolThreadCount(pool);
+    HpaLocal** locals = (HpaLocal**)calloc((size_t)workers, sizeof(HpaLocal*));
+    bool ok = locals != NULL;
+    for (int w = 0; ok && w < workers; w++) {
+        locals[w] = HpaLocalCreate(g->clusterSize);
+        ok = locals[w] != NULL;
+    }
+    if (ok) {
+        std::atomic<int> failed(0);
+        HpaBuildJob job = { g, maze, locals, &failed };
+        ParallelPoolRun(pool, g->clusterCount, HpaBuildTask, &job);
+        ok = failed.load() == 0;
+    }
+    if (locals != NULL) {
+        for (int w = 0; w < workers; w++) {
+            HpaLocalDestroy(locals[w]);
+        }
+        free(locals);
+    }
+    ParallelPoolDestroy(pool);
+    if (ok) HpaRenumber(g);
+    return ok;
+}
+
+HpaGraph* HpaCreate(const Maze* maze, const int* costTable, int clusterSize, int threads) {
+    HpaGraph* g = (HpaGraph*)calloc(1, sizeof(HpaGraph));
+    if (g == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣֲͼṹ");
+        return NULL;
+    }
+    g->rows = maze->rows;
+    g->cols = maze->cols;
+    g->clusterSize = clusterSize > 0 ? clusterSize : HPA_CLUSTER_SIZE;
+    g->clusterRows = (maze->rows + g->clusterSize - 1) / g->clusterSize;
+    g->clusterCols = (maze->cols + g->clusterSize - 1) / g->clusterSize;
+    g->clusterCount = g->clusterRows * g->clusterCols;
+    g->costTable = costTable;
+    g->minCost = INT_MAX;
+    for (int t = 0; t < CELL_TYPE_COUNT; t++) {
+        if (costTable[t] != COST_IMPASSABLE && costTable[t] < g->minCost) g->minCost = costTable[t];
+    }
+    if (g->minCost == INT_MAX) g->minCost = 0;
+
+    g->clusters = (HpaCluster*)calloc((size_t)g->clusterCount, sizeof(HpaCluster));
+    g->nodeBase = (int*)malloc((size_t)(g->clusterCount + 1) * sizeof(int));
+    g->local = HpaLocalCreate(g->clusterSize);
+    if (g->clusters == NULL || g->nodeBase == NULL || g->local == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣֲͼ%dأ", g->clusterCount);
+        HpaDestroy(g);
+        return NULL;
+    }
+    for (int cy = 0; cy < g->clusterRows; cy++) {
+        for (int cx = 0; cx < g->clusterCols; cx++) {
+            HpaCluster* c = &g->clusters[cy * g->clusterCols + cx];
+            c->x0 = cx * g->clusterSize;
+            c->y0 = cy * g->clusterSize;
+            c->width = (c->x0 + g->clusterSize <= g->cols) ? g->clusterSize : g->cols - c->x0;
+            c->height = (c->y0 + g->clusterSize <= g->rows) ? g->clusterSize : g->rows - c->y0;
+        }
+    }
+
+    if (!HpaBuildAll(g, maze, threads)) {
+        TraceLog(LOG_ERROR, "ֲͼԤʧܣڴ治㣩");
+        HpaDestroy(g);
+        return NULL;
+    }
+    return g;
+}
+
+void HpaDestroy(HpaGraph* g) {
+    if (g == NULL) return;
+    if (g->clusters != NULL) {
+        for (int i = 0; i < g->clusterCount; i++) {
+            HpaClusterRelease(&g->clusters[i]);
+        }
+        free(g->clusters);
+    }
+    free(g->nodeBase);
+    HpaLocalDestroy(g->local);
+    free(g);
+}
+
+bool HpaSetCell(HpaGraph* g, Maze* maze, int x, int y, CellType type) {
+    if (x < 0 || x >= g->cols || y < 0 || y >= g->rows) return false;
+    maze->grid[y * g->cols + x] = (signed char)type;
+
+    // ڴرؽӽر߽ʱ߽һصҲ仯
+    int cx = x / g->clusterSize;
+    int cy = y / g->clusterSize;
+    int targets[5];
+    int count = 0;
+    targets[count++] = cy * g->clusterCols + cx;
+    if (x % g->clusterSize == 0 && cx > 0) targets[count++] = cy * g->clusterCols + cx - 1;
+    if (x % g->clusterSize == g->clusterSize - 1 && cx + 1 < g->clusterCols) targets[count++] = cy * g->clusterCols + cx + 1;
+    if (y % g->clusterSize == 0 && cy > 0) targets[count++] = (cy - 1) * g->clusterCols + cx;
+    if (y % g->clusterSize == g->clusterSize - 1 && cy + 1 < g->clusterRows) targets[count++] = (cy + 1) * g->clusterCols + cx;
+
+    g->rebuilt = 0;
+    bool ok = true;
+    for (int i = 0; ok && i < count; i++) {
+        ok = HpaBuildCluster(g, maze, targets[i], g->local);
+        if (ok) g->rebuilt++;
+    }
+    // ʧܵĴѱգûڣ±Աֱһ
+    HpaRenumber(g);
+    if (!ok) TraceLog(LOG_ERROR, "ڴʧܣؽֲͼĴ");
+    return ok;
+}
+
+HpaSearch* HpaSearchCreate(int clusterSize) {
+    HpaSearch* search = (HpaSearch*)calloc(1, sizeof(HpaSearch));
+    if (search == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣֲͼѯṹ");
+        return NULL;
+    }
+    search->clusterSize = clusterSize > 0 ? clusterSize : HPA_CLUSTER_SIZE;
+    search->generation = 2;
+    search->local = HpaLocalCreate(search->clusterSize);
+    if (search->local == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣֲͼѯ");
+        free(search);
+        return NULL;
+    }
+    return search;
+}
+
+void HpaSearchDestroy(HpaSearch* search) {
+    if (search == NULL) return;
+    free(search->stamp);
+    free(search->score);
+    free(search->parent);
+    free(search->route);
+    IndexedHeapDestroy(search->heap);
+    free(search->startCost);
+    free(search->goalCost);
+    HpaLocalDestroy(search->local);
+    free(search);
+}
+
+// ȷѯ㹻ɷֲͼǰʼһγ
+static bool HpaPrepareSearch(const HpaGraph* g, HpaSearch* w) {
+    if (g->widestCluster > w->clusterNodeCapacity) {
+        free(w->startCost);
+        free(w->goalCost);
+        w->startCost = (int*)malloc((size_t)g->widestCluster * sizeof(int));
+        w->goalCost = (int*)malloc((size_t)g->widestCluster * sizeof(int));
+        w->clusterNodeCapacity = (w->startCost != NULL && w->goalCost != NULL) ? g->widestCluster : 0;
+        if (w->clusterNodeCapacity == 0) return false;
+    }
+
+    int needed = g->nodeTotal + 2;
+    if (needed > w->searchCapacity) {
+        free(w->stamp);
+        free(w->score);
+        free(w->parent);
+        free(w->route);
+        IndexedHeapDestroy(w->heap);
+        w->stamp = (unsigned int*)calloc((size_t)needed, sizeof(unsigned int));
+        w->score = (int*)malloc((size_t)needed * sizeof(int));
+        w->parent = (int*)malloc((size_t)needed * sizeof(int));
+        w->route = (int*)malloc((size_t)needed * sizeof(int));
+        w->heap = IndexedHeapCreate(needed);
+        w->generation = 2;
+        bool ok = w->stamp != NULL && w->score != NULL && w->parent != NULL && w->route != NULL && w->heap != NULL;
+        w->searchCapacity = ok ? needed : 0;
+        if (!ok) return false;
+    }
+
+    // ŵʹϴıȫʧЧʱ㣩
+    w->generation += 2;
+    if (w->generation < 2) {
+        memset(w->stamp, 0, (size_t)w->searchCapacity * sizeof(unsigned int));
+        w->generation = 2;
+    }
+    IndexedHeapClear(w->heap);
+    return true;
+}
+
+// ȫڱתڴڱ
+static void HpaDecodeNode(const HpaGraph* g, int id, int* cluster, int* local) {
+    int lo = 0;
+    int hi = g->clusterCount - 1;
+    while (lo < hi) {
+        int mid = (lo + hi + 1) >> 1;
+        if (g->nodeBase[mid] <= id) lo = mid;
+        else hi = mid - 1;
+    }
+    *cluster = lo;
+    *local = id - g->nodeBase[lo];
+}
+
+// ڴصڱвҸӣڷ-1
+static int HpaFindNode(const HpaCluster* c, int cell) {
+    int lo = 0;
+    int hi = c->nodeCount - 1;
+    while (lo <= hi) {
+        int mid = (lo + hi) >> 1;
+        if (c->nodeCell[mid] == cell) return mid;
+        if (c->nodeCell[mid] < cell) lo = mid + 1;
+        else hi = mid - 1;
+    }
+    return -1;
+}
+
+// ͼϵɳڣnodeΪȫֱţcellΪӣյڵ㴫-1
+static void HpaRelax(const HpaGraph* g, HpaSearch* w, int node, int cell, int score, int from, Point end) {
+    SearchStatsRelax(&w->stats);
+    if (w->stamp[node] == w->generation + 1) return;
+    if (w->stamp[node] == w->generation && score >= w->score[node]) return;
+    w->stamp[node] = w->generation;
+    w->score[node] = score;
+    w->parent[node] = from;
+    int h = 0;
+    if (cell >= 0) h = (abs(cell % g->cols - end.x) + abs(cell / g->cols - end.y)) * g->minCost;
+    IndexedHeapPush(w->heap, node, (long long)score + h);
+    SearchStatsPush(&w->stats, w->heap->size);
+}
+
+// Ѵfromto·from׷ӵcells
+static bool HpaAppendLocal(const HpaGraph* g, HpaLocal* local, const Maze* maze, const HpaCluster* c, int from, int to, int* cells, int* length, int maxLen) {
+    HpaLocalSearch(g, maze, c, local, from, to, false);
+    int t = HpaLocalIndex(c, g->cols, to);
+    if (local->dist[t] == INT_MAX) return false;
+    int steps = 0;
+    for (int u = t; local->parent[u] != -1; u = local->parent[u]) steps++;
+    if (*length + steps > maxLen) return false;
+    int u = t;
+    for (int i = *length + steps - 1; i >= *length; i--) {
+        cells[i] = (c->y0 + u / c->width) * g->cols + c->x0 + u % c->width;
+        u = local->parent[u];
+    }
+    *length += steps;
+    return true;
+}
+
+int HpaFindPath(const HpaGraph* g, HpaSearch* w, const Maze* maze, Point start, Point end, int* cells, int maxLen) {
+    w->expanded = 0;
+#if MAZE_STATS
+    memset(&w->stats, 0, sizeof(SearchStats));
+#endif
+    if (start.x < 0 || start.x >= g->cols || start.y < 0 || start.y >= g->rows) return 0;
+    if (end.x < 0 || end.x >= g->cols || end.y < 0 || end.y >= g->rows) return 0;
+    int s = start.y * g->cols + start.x;
+    int t = end.y * g->cols + end.x;
+    if (HpaCellCost(g, maze, s) == COST_IMPASSABLE || HpaCellCost(g, maze, t) == COST_IMPASSABLE || maxLen < 1) return 0;
+    if (!HpaPrepareSearch(g, w)) {
+        TraceLog(LOG_ERROR, "ڴʧܣֲͼ");
+        return 0;
+    }
+
+    // 㡢յֱڴһΣõ֮ĳɱ
+    int cs = HpaClusterOf(g, s);
+    int ct = HpaClusterOf(g, t);
+    const HpaCluster* startCluster = &g->clusters[cs];
+    const HpaCluster* goalCluster = &g->clusters[ct];
+    HpaLocalSearch(g, maze, startCluster, w->local, s, -1, false);
+    for (int i = 0; i < startCluster->nodeCount; i++) {
+        w->startCost[i] = w->local->dist[HpaLocalIndex(startCluster, g->cols, startCluster->nodeCell[i])];
+    }
+    int direct = (cs == ct) ? w->local->dist[HpaLocalIndex(startCluster, g->cols, t)] : INT_MAX;
+    HpaLocalSearch(g, maze, goalCluster, w->local, t, -1, true);
+    for (int i = 0; i < goalCluster->nodeCount; i++) {
+        w->goalCost[i] = w->local->dist[HpaLocalIndex(goalCluster, g->cols, goalCluster->nodeCell[i])];
+    }
+
+    // ͼA*Ϊڵ㣬㡢յڵ
+    int startId = g->nodeTotal;
+    int goalId = g->nodeTotal + 1;
+    HpaRelax(g, w, startId, s, 0, -1, end);
+    bool found = false;
+    while (w->heap->size > 0) {
+        int u = IndexedHeapPop(w->heap);
+        w->stamp[u] = w->generation + 1;
+        w->expanded++;
+        SearchStatsPop(&w->stats);
+        if (u == goalId) {
+            found = true;
+            break;
+        }
+        int gu = w->score[u];
+        if (u == startId) {
+            for (int i = 0; i < startCluster->nodeCount; i++) {
+                if (w->startCost[i] != INT_MAX) HpaRelax(g, w, g->nodeBase[cs] + i, startCluster->nodeCell[i], gu + w->startCost[i], u, end);
+            }
+            if (direct != INT_MAX) HpaRelax(g, w, goalId, -1, gu + direct, u, end);
+            continue;
+        }
+
+        int cluster, local;
+        HpaDecodeNode(g, u, &cluster, &local);
+        const HpaCluster* c = &g->clusters[cluster];
+        int cell = c->nodeCell[local];
+        // ڱ
+        for (int e = c->edgeStart[local]; e < c->edgeStart[local + 1]; e++) {
+            int v = c->edgeTo[e];
+            HpaRelax(g, w, g->nodeBase[cluster] + v, c->nodeCell[v], gu + c->edgeCost[e], u, end);
+        }
+        // رߣڸһǸص
+        int x = cell % g->cols;
+        int y = cell / g->cols;
+        for (int d = 0; d < 4; d++) {
+            int nx = x + HPA_DX[d];
+            int ny = y + HPA_DY[d];
+            if (nx < 0 || nx >= g->cols || ny < 0 || ny >= g->rows) continue;
+            int ncell = ny * g->cols + nx;
+            int ncluster = HpaClusterOf(g, ncell);
+            if (ncluster == cluster) continue;
+            int nlocal = HpaFindNode(&g->clusters[ncluster], ncell);
+            if (nlocal < 0) continue;
+            HpaRelax(g, w, g->nodeBase[ncluster] + nlocal, ncell, gu + HpaCellCost(g, maze, ncell), u, end);
+        }
+        // յڴصڿֱյ
+        if (cluster == ct && w->goalCost[local] != INT_MAX) HpaRelax(g, w, goalId, -1, gu + w->goalCost[local], u, end);
+    }
+    if (!found) return 0;
+
+    // ȡ·㵽յ㣩
+    int hops = 0;
+    for (int u = goalId; u != -1; u = w->parent[u]) hops++;
+    int u = goalId;
+    for (int i = hops - 1; i >= 0; i--) {
+        w->route[i] = u;
+        u = w->parent[u];
+    }
+
+    // ϸڶһδضֱһ
+    int length = 0;
+    cells[length++] = s;
+    for (int i = 0; i + 1 < hops; i++) {
+        int a = w->route[i];
+        int b = w->route[i + 1];
+        bool ok;
+        if (a == startId) {
+            if (b == goalId) {
+                ok = HpaAppendLocal(g, w->local, maze, startCluster, s, t, cells, &length, maxLen);
+            }
+            else {
+                int bc, bl;
+                HpaDecodeNode(g, b, &bc, &bl);
+                ok = HpaAppendLocal(g, w->local, maze, startCluster, s, g->clusters[bc].nodeCell[bl], cells, &length, maxLen);
+            }
+        }
+        else {
+            int ac, al;
+            HpaDecodeNode(g, a, &ac, &al);
+            int aCell = g->clusters[ac].nodeCell[al];
+            if (b == goalId) {
+                ok = HpaAppendLocal(g, w->local, maze, goalCluster, aCell, t, cells, &length, maxLen);
+            }
+            else {
+                int bc, bl;
+                HpaDecodeNode(g, b, &bc, &bl);
+                int bCell = g->clusters[bc].nodeCell[bl];
+                if (ac == bc) {
+                    ok = HpaAppendLocal(g, w->local, maze, &g->clusters[ac], aCell, bCell, cells, &length, maxLen);
+                }
+                else {
+                    ok = length < maxLen;
+                    if (ok) cells[length++] = bCell;
+                }
+            }
+        }
+        if (!ok) {
+            TraceLog(LOG_WARNING, "ֲ·ϸʧܣ·%dѹڣ", maxLen);
+            return 0;
+        }
+    }
+    return length;
+}
+
+size_t HpaMemoryBytes(const HpaGraph* g) {
+    if (g == NULL) return 0;
+    size_t bytes = sizeof(HpaGraph) + (size_t)g->clusterCount * sizeof(HpaCluster) + (size_t)(g->clusterCount + 1) * sizeof(int);
+    for (int i = 0; i < g->clusterCount; i++) {
+        const HpaCluster* c = &g->clusters[i];
+        bytes += (size_t)c->nodeCount * sizeof(int) * 2 + sizeof(int);
+        if (c->edgeStart != NULL) bytes += (size_t)c->edgeStart[c->nodeCount] * sizeof(int) * 2;
+    }
+    bytes += (size_t)g->clusterSize * g->clusterSize * (4 * sizeof(int) + sizeof(long long));
+    return bytes;
+}
+
+size_t HpaSearchMemoryBytes(const HpaSearch* search) {
+    if (search == NULL) return 0;
+    size_t bytes = sizeof(HpaSearch);
+    bytes += (size_t)search->searchCapacity * (sizeof(unsigned int) + 3 * sizeof(int) + 2 * sizeof(int) + sizeof(long long));
+    bytes += (size_t)search->clusterNodeCapacity * 2 * sizeof(int);
+    bytes += (size_t)search->clusterSize * search->clusterSize * (4 * sizeof(int) + sizeof(long long));
+    return bytes;
+}
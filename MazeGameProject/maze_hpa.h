@@ -0,0 +1,83 @@
+#pragma once
+#ifndef MAZE_HPA_H
+#define MAZE_HPA_H
+
+#include "maze_config.h"
+#include "maze_queue.h"
+
+// ֲѰ·HPA*񰴹̶ߴзΪأڴر߽Ŀͨжѡڣ
+// Ԥȼÿ̳֮ɱγɱݵ/Ҽ룩
+// ѯʱڹɵĳͼA*ڴϸΪ·
+// ǽ·ֻѡڡÿڴڣģǸء
+
+constexpr int HPA_CLUSTER_SIZE = 32;   // Ĭϴر߳
+constexpr int HPA_SPLIT_LENGTH = 6;    // ߽δﵽóʱ˸һڣֻеһ
+
+// أΪڽ߽ĸӣڱ߰CSR洢
+typedef struct {
+    int x0;             // Ͻ
+    int y0;             // Ͻ
+    int width;          // 
+    int height;         // ߶
+    int nodeCount;      // 
+    int* nodeCell;      // ڸ±꣨
+    int* edgeStart;     // iĴڳΪedgeStart[i]~edgeStart[i+1]-1
+    int* edgeTo;        // ָڣڱţ
+    int* edgeCost;      // ·ɱ
+} HpaCluster;
+
+// ֲͼ
+typedef struct HpaGraph {
+    int rows;                   // Թ
+    int cols;                   // Թ
+    int clusterSize;            // ر߳
+    int clusterRows;            // ص
+    int clusterCols;            // ص
+    int clusterCount;           // 
+    HpaCluster* clusters;
+    const int* costTable;       // γɱ
+    int minCost;                // ͨеεСɱã
+    int* nodeBase;              // ڵȫֱ㣨clusterCount+1ػؽ¼㣩
+    int nodeTotal;              // 
+    int widestCluster;          // ص
+    struct HpaLocal* local;     // ؽã
+    int rebuilt;                // һ޸ĵؿʱؽĴ
+} HpaGraph;
+
+// ѯֲͼڲѯʱֻ߳̿ɹһݷֲͼԳһѯ
+typedef struct HpaSearch {
+    int clusterSize;            // ر߳ڹ˷䣩
+    // ͼΪ+2յڵ㣬仯ݣ
+    int searchCapacity;
+    unsigned int generation;
+    unsigned int* stamp;
+    int* score;
+    int* parent;
+    int* route;                 // ·
+    IndexedHeap* heap;
+    int* startCost;             // 㵽ڴظڵĳɱ
+    int* goalCost;              // յڴظڵյĳɱ
+    int clusterNodeCapacity;    // startCost/goalCost
+    struct HpaLocal* local;     // /յڴصϸ
+    int expanded;               // һβѯչĳڵ
+    SearchStats stats;          // һβѯڳͼϵͳƣϸƣ
+} HpaSearch;
+
+// ֲͼclusterSize<=0ʹĬֵԤָthreadṣ߳<=0ΪȫӲ̣߳
+HpaGraph* HpaCreate(const Maze* maze, const int* costTable, int clusterSize, int threads);
+// ͷŷֲͼ
+void HpaDestroy(HpaGraph* g);
+// ޸ĵؿ鲢ֻؽӰĴأڴأλڴر߽ʱ߽ͬһĴأ
+bool HpaSetCell(HpaGraph* g, Maze* maze, int x, int y, CellType type);
+// ѯر߳ѯķֲͼһ£
+HpaSearch* HpaSearchCreate(int clusterSize);
+// ͷŲѯ
+void HpaSearchDestroy(HpaSearch* search);
+// ѯ·㵽յд±꣨·ɴ򳬹maxLen0޸ķֲͼ
+int HpaFindPath(const HpaGraph* g, HpaSearch* search, const Maze* maze, Point start, Point end, int* cells, int maxLen);
+// ͳƷֲͼռõĶڴ棨ֽڣѯ
+size_t HpaMemoryBytes(const HpaGraph* g);
+// ͳƲѯռõĶڴ棨ֽڣ
+size_t HpaSearchMemoryBytes(const HpaSearch* search);
+
+#endif // MAZE_HPA_H
@@ -0,0 +1,82 @@
+#include "maze_mmap.h"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+bool MappedFileOpen(MappedFile* mf, const char* filename) {
+    mf->data = NULL;
+    mf->size = 0;
+    mf->fileHandle = NULL;
+    mf->mapHandle = NULL;
+
+#ifdef _WIN32
+    HANDLE file = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+        OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    // PAGE_WRITECOPY + FILE_MAP_COPYдֻӰ챾̵˽ҳ
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_WRITECOPY, 0, 0, NULL);
+    if (mapping == NULL) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+    if (view == NULL) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mf->data = (unsigned char*)view;
+    mf->size = (size_t)fileSize.QuadPart;
+    mf->fileHandle = file;
+    mf->mapHandle = mapping;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) {
+        close(fd);
+        return false;
+    }
+
+    // MAP_PRIVATEдʱƣ޸Ĵϵļ
+    void* view = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd); // ӳ佨󼴿ɹرļ
+    if (view == MAP_FAILED) return false;
+    madvise(view, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    mf->data = (unsigned char*)view;
+    mf->size = (size_t)st.st_size;
+#endif
+    return true;
+}
+
+void MappedFileClose(MappedFile* mf) {
+    if (mf == NULL || mf->data == NULL) return;
+#ifdef _WIN32
+    UnmapViewOfFile(mf->data);
+    CloseHandle((HANDLE)mf->mapHandle);
+    CloseHandle((HANDLE)mf->fileHandle);
+#else
+    munmap(mf->data, mf->size);
+#endif
+    mf->data = NULL;
+    mf->size = 0;
+    mf->fileHandle = NULL;
+    mf->mapHandle = NULL;
+}
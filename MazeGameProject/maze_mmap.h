@@ -0,0 +1,22 @@
+#pragma once
+#ifndef MAZE_MMAP_H
+#define MAZE_MMAP_H
+
+// ע⣺ͷļraylib.hԱʵļ԰ȫذwindows.h
+#include <stddef.h>
+#include <stdbool.h>
+
+// ڴӳļдʱƣӳд޸Ĳдش̣
+typedef struct {
+    unsigned char* data;   // ӳ׵ַ
+    size_t size;           // ļСֽڣ
+    void* fileHandle;      // ƽ̨ļ
+    void* mapHandle;       // ƽ̨ӳWindowsʹã
+} MappedFile;
+
+// дʱƷʽӳļļΪʧܣ
+bool MappedFileOpen(MappedFile* mf, const char* filename);
+// ӳ䲢رļ
+void MappedFileClose(MappedFile* mf);
+
+#endif // MAZE_MMAP_H
@@ -0,0 +1,208 @@
+#include "maze_parallel.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+
+int ParallelThreadCount(int requested) {
+    if (requested > 0) return requested;
+    int hardware = (int)std::thread::hardware_concurrency();
+    return hardware > 0 ? hardware : 1;
+}
+
+// ̣߳ӹȡһֱȫ
+static void ParallelWorker(std::atomic<int>* next, int count, ParallelTaskFunc task, void* context) {
+    for (;;) {
+        int index = next->fetch_add(1, std::memory_order_relaxed);
+        if (index >= count) break;
+        task(index, context);
+    }
+}
+
+void ParallelFor(int count, int threadCount, ParallelTaskFunc task, void* context) {
+    if (count <= 0) return;
+    threadCount = ParallelThreadCount(threadCount);
+    if (threadCount > count) threadCount = count;
+
+    std::atomic<int> next(0);
+    if (threadCount == 1) {
+        ParallelWorker(&next, count, task, context);
+        return;
+    }
+
+    // ǰ߳Ҳִ
+    std::vector<std::thread> workers;
+    workers.reserve((size_t)threadCount - 1);
+    for (int t = 1; t < threadCount; t++) {
+        workers.emplace_back(ParallelWorker, &next, count, task, context);
+    }
+    ParallelWorker(&next, count, task, context);
+    for (size_t t = 0; t < workers.size(); t++) {
+        workers[t].join();
+    }
+}
+
+// ̵߳[begin, end)һ64λԭУ32λbegin32λend
+// ߳ȡ߳ȡCAS޸ģ뵽бα
+struct ParallelRange {
+    std::atomic<unsigned long long> value;
+    char padding[64 - sizeof(std::atomic<unsigned long long>)];
+};
+
+struct ParallelPool {
+    int threadCount;
+    ParallelRange* ranges;             // ÿ߳һ
+    std::vector<std::thread> threads;  // 1~threadCount-1̣߳0Ϊ̣߳
+    std::mutex mutex;
+    std::condition_variable wake;      // ֪ͨ߳˳
+    std::condition_variable finished;  // ֪̱ͨ߳
+    unsigned long long batch;          // κţÿParallelPoolRun1
+    int running;                       // ִбĹ߳
+    bool quit;
+    ParallelWorkerTaskFunc task;
+    void* context;
+};
+
+static unsigned long long PackRange(int begin, int end) {
+    return ((unsigned long long)(unsigned int)begin << 32) | (unsigned int)end;
+}
+
+static int RangeBegin(unsigned long long range) { return (int)(range >> 32); }
+static int RangeEnd(unsigned long long range) { return (int)(range & 0xFFFFFFFFULL); }
+
+// Լǰȡһ
+static bool PoolPopLocal(ParallelPool* pool, int worker, int* index) {
+    std::atomic<unsigned long long>& range = pool->ranges[worker].value;
+    unsigned long long old = range.load(std::memory_order_acquire);
+    for (;;) {
+        int begin = RangeBegin(old);
+        int end = RangeEnd(old);
+        if (begin >= end) return false;
+        if (range.compare_exchange_weak(old, PackRange(begin + 1, end), std::memory_order_acq_rel)) {
+            *index = begin;
+            return true;
+        }
+    }
+}
+
+// Լδ߳ĺȡһ루ʣ಻2ߣ
+static bool PoolSteal(ParallelPool* pool, int worker) {
+    for (int k = 1; k < pool->threadCount; k++) {
+        int victim = (worker + k) % pool->threadCount;
+        std::atomic<unsigned long long>& range = pool->ranges[victim].value;
+        unsigned long long old = range.load(std::memory_order_acquire);
+        for (;;) {
+            int begin = RangeBegin(old);
+            int end = RangeEnd(old);
+            if (end - begin < 2) break;
+            int middle = begin + (end - begin) / 2;
+            if (range.compare_exchange_weak(old, PackRange(begin, middle), std::memory_order_acq_rel)) {
+                pool->ranges[worker].value.store(PackRange(middle, end), std::memory_order_release);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// ִбֱ䶼޷ȡȡ
+static void PoolWork(ParallelPool* pool, int worker) {
+    int index;
+    for (;;) {
+        if (PoolPopLocal(pool, worker, &index)) {
+            pool->task(index, worker, pool->context);
+        }
+        else if (!PoolSteal(pool, worker)) {
+            break;
+        }
+    }
+}
+
+// ̣߳ȴΣִ֪ͨ߳
+static void PoolThread(ParallelPool* pool, int worker) {
+    unsigned long long seen = 0;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(pool->mutex);
+            pool->wake.wait(lock, [&] { return pool->quit || pool->batch != seen; });
+            if (pool->quit) return;
+            seen = pool->batch;
+        }
+        PoolWork(pool, worker);
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        if (--pool->running == 0) pool->finished.notify_one();
+    }
+}
+
+ParallelPool* ParallelPoolCreate(int threadCount) {
+    ParallelPool* pool = new (std::nothrow) ParallelPool();
+    if (pool == NULL) return NULL;
+    pool->threadCount = ParallelThreadCount(threadCount);
+    pool->ranges = new (std::nothrow) ParallelRange[pool->threadCount];
+    if (pool->ranges == NULL) {
+        delete pool;
+        return NULL;
+    }
+    for (int t = 0; t < pool->threadCount; t++) {
+        pool->ranges[t].value.store(0, std::memory_order_relaxed);
+    }
+    pool->batch = 0;
+    pool->running = 0;
+    pool->quit = false;
+    pool->task = NULL;
+    pool->context = NULL;
+    pool->threads.reserve((size_t)pool->threadCount - 1);
+    for (int t = 1; t < pool->threadCount; t++) {
+        pool->threads.emplace_back(PoolThread, pool, t);
+    }
+    return pool;
+}
+
+void ParallelPoolDestroy(ParallelPool* pool) {
+    if (pool == NULL) return;
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->quit = true;
+    }
+    pool->wake.notify_all();
+    for (size_t t = 0; t < pool->threads.size(); t++) {
+        pool->threads[t].join();
+    }
+    delete[] pool->ranges;
+    delete pool;
+}
+
+int ParallelPoolThreadCount(const ParallelPool* pool) {
+    return pool->threadCount;
+}
+
+void ParallelPoolRun(ParallelPool* pool, int count, ParallelWorkerTaskFunc task, void* context) {
+    if (count <= 0) return;
+
+    // Űָ߳
+    for (int t = 0; t < pool->threadCount; t++) {
+        int begin = (int)((long long)count * t / pool->threadCount);
+        int end = (int)((long long)count * (t + 1) / pool->threadCount);
+        pool->ranges[t].value.store(PackRange(begin, end), std::memory_order_relaxed);
+    }
+    if (pool->threadCount == 1) {
+        pool->task = task;
+        pool->context = context;
+        PoolWork(pool, 0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pool->mutex);
+        pool->task = task;
+        pool->context = context;
+        pool->running = pool->threadCount - 1;
+        pool->batch++;
+    }
+    pool->wake.notify_all();
+    PoolWork(pool, 0);
+    std::unique_lock<std::mutex> lock(pool->mutex);
+    pool->finished.wait(lock, [&] { return pool->running == 0; });
+}
@@ -0,0 +1,33 @@
+#pragma once
+#ifndef MAZE_PARALLEL_H
+#define MAZE_PARALLEL_H
+
+// ע⣺ģ鲻raylibͼλ
+#include <stddef.h>
+
+// indexΪţcontextΪ÷
+typedef void (*ParallelTaskFunc)(int index, void* context);
+
+// ߳<=0ʾʹȫӲ̣߳
+int ParallelThreadCount(int requested);
+// ѱ0~count-1ָthreadCountִ߳Уȫɺ󷵻أ߳Ϊ1ʱڵǰִ߳У
+void ParallelFor(int count, int threadCount, ParallelTaskFunc task, void* context);
+
+// ̳߳workerΪִи̱߳ţ0~߳-1ѡȡ߳˽еĹ
+typedef void (*ParallelWorkerTaskFunc)(int index, int worker, void* context);
+
+// פ̳߳أȡֻ߳ڴʱһΣύٴ̡߳
+// ÿȰẓ̴ָ̌߳߳Լǰȡ
+// Լ߳ĺȡһ룬ʱʱҲָܱ߳æµ
+typedef struct ParallelPool ParallelPool;
+
+// ̳߳أthreadCount<=0ʾʹȫӲ̣߳߳Ϊ0ִ̲߳У
+ParallelPool* ParallelPoolCreate(int threadCount);
+// ̳߳أȴ߳˳
+void ParallelPoolDestroy(ParallelPool* pool);
+// ̳߳ص̣߳߳
+int ParallelPoolThreadCount(const ParallelPool* pool);
+// ִб0~count-1ȫɺ󷵻أͬһ̳߳زͬʱ̵߳ã
+void ParallelPoolRun(ParallelPool* pool, int count, ParallelWorkerTaskFunc task, void* context);
+
+#endif // MAZE_PARALLEL_H
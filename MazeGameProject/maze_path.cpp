@@ -0,0 +1,250 @@
+#include "maze_path.h"
+#include "maze_utils.h"
+#include <string.h>
+
+// ڽӷϡ¡ңں˵ǰ4һ£
+static const int PATH_DX[4] = { 0, 0, -1, 1 };
+static const int PATH_DY[4] = { -1, 1, 0, 0 };
+
+// ֮һķ򣨲ڽʱ-1
+static int PathStepDirection(Point from, Point to) {
+    int dx = to.x - from.x;
+    int dy = to.y - from.y;
+    if (dx == 0 && dy == -1) return 0;
+    if (dx == 0 && dy == 1) return 1;
+    if (dx == -1 && dy == 0) return 2;
+    if (dx == 1 && dy == 0) return 3;
+    return -1;
+}
+
+// ȷ洢bytesֽڣbytesֽڣ
+static bool MazePathReserve(MazePath* path, size_t bytes) {
+    if (bytes <= path->capacity) return true;
+    unsigned char* grown = (unsigned char*)realloc(path->data, bytes);
+    if (grown == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ·洢%lluֽڣ", (unsigned long long)bytes);
+        return false;
+    }
+    path->data = grown;
+    path->capacity = bytes;
+    return true;
+}
+
+// ׷ʱݣ̯O(1)
+static bool MazePathGrow(MazePath* path, size_t bytes) {
+    if (bytes <= path->capacity) return true;
+    size_t capacity = path->capacity > 0 ? path->capacity * 2 : 64;
+    return MazePathReserve(path, capacity > bytes ? capacity : bytes);
+}
+
+// ѷֱ߶չΪ飨׷бߵһ֮ǰã
+static bool MazePathToPoints(MazePath* path) {
+    Point* points = (Point*)malloc(((size_t)path->length + 1) * sizeof(Point));
+    if (points == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ·飨%dӣ", path->length + 1);
+        return false;
+    }
+    MazePathIter it;
+    MazePathIterBegin(&it, path);
+    for (int i = 0; MazePathIterNext(&it, &points[i]); i++) {}
+    free(path->data);
+    path->data = (unsigned char*)points;
+    path->capacity = ((size_t)path->length + 1) * sizeof(Point);
+    path->bytes = (size_t)path->length * sizeof(Point);
+    path->encoding = PATH_POINTS;
+    path->runCount = 0;
+    return true;
+}
+
+const char* PathEncodingName(PathEncoding encoding) {
+    static const char* names[PATH_ENCODING_COUNT] = { "points", "directions", "runs" };
+    return (encoding >= 0 && encoding < PATH_ENCODING_COUNT) ? names[encoding] : "unknown";
+}
+
+void MazePathInit(MazePath* path, PathEncoding preferred) {
+    path->preferred = preferred;
+    path->encoding = preferred;
+    path->data = NULL;
+    path->capacity = 0;
+    path->revision = 0;
+    MazePathClear(path);
+}
+
+void MazePathFree(MazePath* path) {
+    free(path->data);
+    path->data = NULL;
+    path->capacity = 0;
+    MazePathClear(path);
+}
+
+void MazePathClear(MazePath* path) {
+    path->encoding = path->preferred;
+    path->length = 0;
+    path->start.x = path->start.y = 0;
+    path->end = path->start;
+    path->runCount = 0;
+    path->bytes = 0;
+    path->revision++;
+}
+
+bool MazePathAppend(MazePath* path, Point cell) {
+    if (path->length == 0) {
+        path->encoding = path->preferred;
+        if (path->encoding == PATH_POINTS) {
+            if (!MazePathGrow(path, sizeof(Point))) return false;
+            memcpy(path->data, &cell, sizeof(Point));
+            path->bytes = sizeof(Point);
+        }
+        path->start = cell;
+        path->end = cell;
+        path->length = 1;
+        path->revision++;
+        return true;
+    }
+
+    int dir = PathStepDirection(path->end, cell);
+    if (dir < 0 && path->encoding != PATH_POINTS && !MazePathToPoints(path)) return false;
+    if (path->encoding == PATH_POINTS) {
+        if (!MazePathGrow(path, path->bytes + sizeof(Point))) return false;
+        memcpy(path->data + path->bytes, &cell, sizeof(Point));
+        path->bytes += sizeof(Point);
+    }
+    else if (path->encoding == PATH_DIRECTIONS) {
+        int step = path->length - 1;
+        if ((step & 3) == 0) {
+            if (!MazePathGrow(path, path->bytes + 1)) return false;
+            path->data[path->bytes++] = 0;
+        }
+        path->data[step >> 2] |= (unsigned char)(dir << ((step & 3) * 2));
+    }
+    else {
+        unsigned int* runs = (unsigned int*)path->data;
+        if (path->runCount > 0 && (int)(runs[path->runCount - 1] & 3) == dir) {
+            runs[path->runCount - 1] += 1u << 2;
+        }
+        else {
+            if (!MazePathGrow(path, path->bytes + sizeof(unsigned int))) return false;
+            runs = (unsigned int*)path->data;
+            runs[path->runCount++] = (1u << 2) | (unsigned int)dir;
+            path->bytes += sizeof(unsigned int);
+        }
+    }
+    path->end = cell;
+    path->length++;
+    path->revision++;
+    return true;
+}
+
+size_t MazePathMemoryBytes(const MazePath* path) {
+    return path->capacity;
+}
+
+int PathBacktrack(const Maze* maze, const PathData* pd, MazePath* path) {
+    MazePathClear(path);
+    int startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    int endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+
+    // һ飺ֱ߶ȷܻص㡢ÿڽӣ·л
+    int length = 0;
+    int runCount = 0;
+    int lastDir = -1;
+    bool straight = true;
+    int current = endIndex;
+    while (current != -1 && length < pd->cellCount) {
+        length++;
+        if (current == startIndex) break;
+        int parent = PathDataParent(pd, current);
+        if (parent != -1) {
+            int dir = PathStepDirection(MazePointFromIndex(maze, parent), MazePointFromIndex(maze, current));
+            if (dir < 0) straight = false;
+            else if (dir != lastDir) runCount++;
+            lastDir = dir;
+        }
+        current = parent;
+    }
+    if (current != startIndex) {
+        TraceLog(LOG_WARNING, "·δݵ㣬·ͨ");
+        return 0;
+    }
+
+    // һη䵽λֱ߶β᳤Թıֶ߳β
+    PathEncoding encoding = straight ? path->preferred : PATH_POINTS;
+    size_t bytes;
+    if (encoding == PATH_POINTS) bytes = (size_t)length * sizeof(Point);
+    else if (encoding == PATH_DIRECTIONS) bytes = ((size_t)length + 2) / 4;
+    else bytes = (size_t)runCount * sizeof(unsigned int);
+    if (!MazePathReserve(path, bytes)) return 0;
+    if (encoding == PATH_DIRECTIONS) memset(path->data, 0, bytes);
+
+    // ڶ飺յߣλôβǰд
+    Point* points = (Point*)path->data;
+    unsigned int* runs = (unsigned int*)path->data;
+    int run = runCount;
+    lastDir = -1;
+    current = endIndex;
+    for (int i = length - 1; i >= 0; i--) {
+        Point cell = MazePointFromIndex(maze, current);
+        if (encoding == PATH_POINTS) points[i] = cell;
+        if (i == 0) break;
+        int parent = PathDataParent(pd, current);
+        if (encoding != PATH_POINTS) {
+            // i-1parentߵcurrent
+            int dir = PathStepDirection(MazePointFromIndex(maze, parent), cell);
+            int step = i - 1;
+            if (encoding == PATH_DIRECTIONS) path->data[step >> 2] |= (unsigned char)(dir << ((step & 3) * 2));
+            else if (dir == lastDir) runs[run] += 1u << 2;
+            else runs[--run] = (1u << 2) | (unsigned int)dir;
+            lastDir = dir;
+        }
+        current = parent;
+    }
+
+    path->encoding = encoding;
+    path->length = length;
+    path->start = maze->start;
+    path->end = maze->end;
+    path->runCount = encoding == PATH_RUNS ? runCount : 0;
+    path->bytes = bytes;
+    path->revision++;
+    TraceLog(LOG_INFO, "·ɣ·ȣ%d%s%lluֽڣ", length, PathEncodingName(encoding), (unsigned long long)bytes);
+    return length;
+}
+
+void MazePathIterBegin(MazePathIter* it, const MazePath* path) {
+    it->path = path;
+    it->index = 0;
+    it->cell = path->start;
+    it->run = 0;
+    it->runLeft = 0;
+    it->runDir = 0;
+}
+
+bool MazePathIterNext(MazePathIter* it, Point* cell) {
+    const MazePath* path = it->path;
+    if (it->index >= path->length) return false;
+    *cell = it->cell;
+    int step = it->index++;
+    if (it->index >= path->length) return true;
+
+    // Ԥߵһ
+    int dir;
+    if (path->encoding == PATH_POINTS) {
+        memcpy(&it->cell, path->data + (size_t)it->index * sizeof(Point), sizeof(Point));
+        return true;
+    }
+    if (path->encoding == PATH_DIRECTIONS) {
+        dir = (path->data[step >> 2] >> ((step & 3) * 2)) & 3;
+    }
+    else {
+        if (it->runLeft == 0) {
+            unsigned int run = ((const unsigned int*)path->data)[it->run++];
+            it->runLeft = (int)(run >> 2);
+            it->runDir = (int)(run & 3);
+        }
+        it->runLeft--;
+        dir = it->runDir;
+    }
+    it->cell.x += PATH_DX[dir];
+    it->cell.y += PATH_DY[dir];
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+#ifndef MAZE_PATH_H
+#define MAZE_PATH_H
+
+#include "maze_config.h"
+
+// ·㵽յĸУ洢ضϡִ洢ʽ
+//   PATH_POINTS      ÿһPoint8ֽ/񣩣
+//   PATH_DIRECTIONS   + ÿ2λϡ¡ңÿֽ4ԼΪPoint1/32
+//   PATH_RUNS         + ֱ߶Σÿ4ֽڣ2λΪԽԽʡ
+// ֱ߶ֻܱʾڽӵĲ·бߣ˷ƶʱԶPATH_POINTS
+// ȡͳһMazePathIter㵽յ˳ȡ
+
+// ·洢ʽ
+typedef enum {
+    PATH_POINTS = 0,   // 
+    PATH_DIRECTIONS,   // 2λ
+    PATH_RUNS,         // ֱ߶
+    PATH_ENCODING_COUNT
+} PathEncoding;
+
+// ·
+typedef struct {
+    PathEncoding preferred;  // Ĵ洢ʽ
+    PathEncoding encoding;   // ǰʵʵĴ洢ʽбʱΪPATH_POINTS
+    int length;              // յ㣬0ʾ·
+    Point start;             // 
+    Point end;               // յ
+    int runCount;            // ֱ߶PATH_RUNS
+    unsigned char* data;     // 洢
+    size_t bytes;            // ֽ
+    size_t capacity;         // ѷֽ
+    unsigned int revision;   // ÿα仯1·ƽһݴжǷҪػ
+} MazePath;
+
+// ·Ⱦ·ƶĽɫã
+typedef struct {
+    const MazePath* path;
+    int index;     // һȡĸ
+    Point cell;    // һȡĸ
+    int run;       // һֱ߶ΣPATH_RUNS
+    int runLeft;   // ǰֱ߶ʣĲ
+    int runDir;    // ǰֱ߶εķ
+} MazePathIter;
+
+// 洢ʽ
+const char* PathEncodingName(PathEncoding encoding);
+// ʼ·ڴ棩
+void MazePathInit(MazePath* path, PathEncoding preferred);
+// ͷŴ洢
+void MazePathFree(MazePath* path);
+// ·洢
+void MazePathClear(MazePath* path);
+// ĩβ׷һ񣨴洢ʱݣһڽʱתΪPATH_POINTSʧܷfalse
+bool MazePathAppend(MazePath* path, Point cell);
+// ·ռõĶڴ棨ֽڣ
+size_t MazePathMemoryBytes(const MazePath* path);
+// ظڵյݵ㣬д·ֱ߶һη䵽λٴβǰд跭ת
+// ·δݵڴ治ʱ0
+int PathBacktrack(const Maze* maze, const PathData* pd, MazePath* path);
+
+// 㿪ʼ
+void MazePathIterBegin(MazePathIter* it, const MazePath* path);
+// ȡһȡʱfalse
+bool MazePathIterNext(MazePathIter* it, Point* cell);
+
+#endif // MAZE_PATH_H
@@ -0,0 +1,198 @@
+#include "maze_queue.h"
+
+IndexedHeap* IndexedHeapCreate(int capacity) {
+    IndexedHeap* h = (IndexedHeap*)malloc(sizeof(IndexedHeap));
+    if (h == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣѽṹ");
+        return NULL;
+    }
+    h->heap = (int*)malloc((size_t)capacity * sizeof(int));
+    h->pos = (int*)malloc((size_t)capacity * sizeof(int));
+    h->key = (long long*)malloc((size_t)capacity * sizeof(long long));
+    if (h->heap == NULL || h->pos == NULL || h->key == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ");
+        IndexedHeapDestroy(h);
+        return NULL;
+    }
+    for (int i = 0; i < capacity; i++) {
+        h->pos[i] = -1;
+    }
+    h->size = 0;
+    h->capacity = capacity;
+    return h;
+}
+
+void IndexedHeapDestroy(IndexedHeap* h) {
+    if (h == NULL) return;
+    free(h->heap);
+    free(h->pos);
+    free(h->key);
+    free(h);
+}
+
+void IndexedHeapClear(IndexedHeap* h) {
+    for (int i = 0; i < h->size; i++) {
+        h->pos[h->heap[i]] = -1;
+    }
+    h->size = 0;
+}
+
+// ϸλiԪƶλ
+static void HeapSiftUp(IndexedHeap* h, int i) {
+    int item = h->heap[i];
+    long long key = h->key[item];
+    while (i > 0) {
+        int parent = (i - 1) >> 1;
+        int parentItem = h->heap[parent];
+        if (h->key[parentItem] <= key) break;
+        h->heap[i] = parentItem;
+        h->pos[parentItem] = i;
+        i = parent;
+    }
+    h->heap[i] = item;
+    h->pos[item] = i;
+}
+
+// ³λiԪƶλ
+static void HeapSiftDown(IndexedHeap* h, int i) {
+    int item = h->heap[i];
+    long long key = h->key[item];
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= h->size) break;
+        if (child + 1 < h->size && h->key[h->heap[child + 1]] < h->key[h->heap[child]]) child++;
+        int childItem = h->heap[child];
+        if (h->key[childItem] >= key) break;
+        h->heap[i] = childItem;
+        h->pos[childItem] = i;
+        i = child;
+    }
+    h->heap[i] = item;
+    h->pos[item] = i;
+}
+
+void IndexedHeapPush(IndexedHeap* h, int item, long long key) {
+    h->key[item] = key;
+    if (h->pos[item] >= 0) {
+        // ڶУͼֵϸ
+        HeapSiftUp(h, h->pos[item]);
+        return;
+    }
+    h->heap[h->size] = item;
+    HeapSiftUp(h, h->size++);
+}
+
+int IndexedHeapPop(IndexedHeap* h) {
+    int top = h->heap[0];
+    h->pos[top] = -1;
+    if (--h->size > 0) {
+        h->heap[0] = h->heap[h->size];
+        HeapSiftDown(h, 0);
+    }
+    return top;
+}
+
+void IndexedHeapUpdate(IndexedHeap* h, int item, long long key) {
+    long long old = h->key[item];
+    h->key[item] = key;
+    if (key < old) HeapSiftUp(h, h->pos[item]);
+    else HeapSiftDown(h, h->pos[item]);
+}
+
+void IndexedHeapRemove(IndexedHeap* h, int item) {
+    int i = h->pos[item];
+    if (i < 0) return;
+    h->pos[item] = -1;
+    if (--h->size == i) return;
+    // ĩβԪλֵٰϸ³
+    int last = h->heap[h->size];
+    h->heap[i] = last;
+    h->pos[last] = i;
+    if (i > 0 && h->key[h->heap[(i - 1) >> 1]] > h->key[last]) HeapSiftUp(h, i);
+    else HeapSiftDown(h, i);
+}
+
+BucketQueue* BucketQueueCreate(int capacity, int maxCost) {
+    BucketQueue* q = (BucketQueue*)malloc(sizeof(BucketQueue));
+    if (q == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣͰнṹ");
+        return NULL;
+    }
+    q->bucketCount = maxCost + 1;
+    q->head = (int*)malloc((size_t)q->bucketCount * sizeof(int));
+    q->next = (int*)malloc((size_t)capacity * sizeof(int));
+    q->prev = (int*)malloc((size_t)capacity * sizeof(int));
+    q->key = (int*)malloc((size_t)capacity * sizeof(int));
+    if (q->head == NULL || q->next == NULL || q->prev == NULL || q->key == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣͰ");
+        BucketQueueDestroy(q);
+        return NULL;
+    }
+    for (int b = 0; b < q->bucketCount; b++) {
+        q->head[b] = -1;
+    }
+    for (int i = 0; i < capacity; i++) {
+        q->key[i] = -1;
+    }
+    q->cursor = 0;
+    q->size = 0;
+    q->capacity = capacity;
+    return q;
+}
+
+void BucketQueueDestroy(BucketQueue* q) {
+    if (q == NULL) return;
+    free(q->head);
+    free(q->next);
+    free(q->prev);
+    free(q->key);
+    free(q);
+}
+
+void BucketQueueClear(BucketQueue* q) {
+    if (q->size > 0) {
+        for (int b = 0; b < q->bucketCount; b++) {
+            for (int item = q->head[b]; item != -1; item = q->next[item]) {
+                q->key[item] = -1;
+            }
+            q->head[b] = -1;
+        }
+    }
+    q->cursor = 0;
+    q->size = 0;
+}
+
+// ͰժԪ
+static void BucketUnlink(BucketQueue* q, int item) {
+    int b = q->key[item] % q->bucketCount;
+    if (q->prev[item] != -1) q->next[q->prev[item]] = q->next[item];
+    else q->head[b] = q->next[item];
+    if (q->next[item] != -1) q->prev[q->next[item]] = q->prev[item];
+}
+
+void BucketQueuePush(BucketQueue* q, int item, int key) {
+    if (q->key[item] >= 0) {
+        BucketUnlink(q, item);
+    }
+    else {
+        q->size++;
+    }
+    int b = key % q->bucketCount;
+    q->key[item] = key;
+    q->prev[item] = -1;
+    q->next[item] = q->head[b];
+    if (q->head[b] != -1) q->prev[q->head[b]] = item;
+    q->head[b] = item;
+}
+
+int BucketQueuePop(BucketQueue* q) {
+    // ֵӵǰֵҵһǿͰһȦ
+    while (q->head[q->cursor % q->bucketCount] == -1) {
+        q->cursor++;
+    }
+    int item = q->head[q->cursor % q->bucketCount];
+    BucketUnlink(q, item);
+    q->key[item] = -1;
+    q->size--;
+    return item;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#ifndef MAZE_QUEUE_H
+#define MAZE_QUEUE_H
+
+#include "maze_config.h"
+
+// ѣԪΪ±꣬ÿڶгһΣֽ֧ͼֵ
+typedef struct IndexedHeap {
+    int* heap;       // 飨±꣩
+    int* pos;        // ڶеλã-1ʾڶУ
+    long long* key;  // ӵǰļֵ64λιؼ֣
+    int size;        // Ԫظ
+    int capacity;    // 
+} IndexedHeap;
+
+// ѣcapacityΪ
+IndexedHeap* IndexedHeapCreate(int capacity);
+// ͷ
+void IndexedHeapDestroy(IndexedHeap* h);
+// ѣֻöʣԪأ
+void IndexedHeapClear(IndexedHeap* h);
+// Ԫأڶʱֵ
+void IndexedHeapPush(IndexedHeap* h, int item, long long key);
+// ֵСԪ
+int IndexedHeapPop(IndexedHeap* h);
+// ޸ڶԪصļֵɽ
+void IndexedHeapUpdate(IndexedHeap* h, int item, long long key);
+// ӶɾԪأڶʱԣ
+void IndexedHeapRemove(IndexedHeap* h, int item);
+
+// ͰУDial㷨ֵҵmaxCostʱʹ
+// maxCost+1ѭͰÿͰǸӵ˫
+typedef struct BucketQueue {
+    int* head;       // ÿͰͷ-1ʾͰ
+    int* next;       // Ͱеĺ
+    int* prev;       // Ͱеǰ
+    int* key;        // ӵǰļֵ-1ʾڶУ
+    int bucketCount; // ͰmaxCost+1
+    int cursor;      // ǰɨ赽ļֵ
+    int size;        // Ԫظ
+    int capacity;    // 
+} BucketQueue;
+
+// ͰУcapacityΪmaxCostΪۣ
+BucketQueue* BucketQueueCreate(int capacity, int maxCost);
+// ͷͰ
+void BucketQueueDestroy(BucketQueue* q);
+// ͰУֻöʣԪأ
+void BucketQueueClear(BucketQueue* q);
+// Ԫأڶʱƶ¼ֵӦͰ
+void BucketQueuePush(BucketQueue* q, int item, int key);
+// ֵСԪ
+int BucketQueuePop(BucketQueue* q);
+
+#endif // MAZE_QUEUE_H
@@ -1,82 +1,541 @@
 #include "maze_render.h"
+#include "rlgl.h"
+#include <math.h>
+#include <string.h>
+
+// ͼиؿ͵ɫ±ΪCellType+2
+static const Color OVERVIEW_COLORS[CELL_TYPE_COUNT] = {
+    Color{ 230, 41, 55, 255 },   // յ
+    Color{ 0, 121, 241, 255 },   // 
+    Color{ 220, 210, 190, 255 }, // ͨ
+    Color{ 60, 60, 70, 255 },    // ǽ
+    Color{ 90, 170, 70, 255 },   // ݵ
+    Color{ 240, 110, 20, 255 }   // 
+};
+
+// ¼ɼӷΧǷʹͼ
+static void MazeViewRefresh(MazeView* view, Maze* maze) {
+    const float step = (float)(CELL_SIZE + CELL_GAP);
+    Vector2 topLeft = GetScreenToWorld2D(Vector2{ 0.0f, 0.0f }, view->camera);
+    Vector2 bottomRight = GetScreenToWorld2D(Vector2{ (float)WINDOW_WIDTH, (float)WINDOW_HEIGHT }, view->camera);
+    view->firstX = (int)floorf(topLeft.x / step);
+    view->firstY = (int)floorf(topLeft.y / step);
+    view->lastX = (int)floorf(bottomRight.x / step);
+    view->lastY = (int)floorf(bottomRight.y / step);
+    if (view->firstX < 0) view->firstX = 0;
+    if (view->firstY < 0) view->firstY = 0;
+    if (view->lastX > maze->cols - 1) view->lastX = maze->cols - 1;
+    if (view->lastY > maze->rows - 1) view->lastY = maze->rows - 1;
+    view->overview = view->camera.zoom < VIEW_DETAIL_MIN_ZOOM;
+}
+
+void MazeViewInit(MazeView* view, Maze* maze) {
+    const float step = (float)(CELL_SIZE + CELL_GAP);
+    float worldWidth = maze->cols * step;
+    float worldHeight = maze->rows * step;
+    float fitX = WINDOW_WIDTH / worldWidth;
+    float fitY = WINDOW_HEIGHT / worldHeight;
+    float fit = fitX < fitY ? fitX : fitY;
+
+    // Ķ׼ԹģԹŵʱԭʼСʾ
+    view->minZoom = fit < 1.0f ? fit : 1.0f;
+    view->camera.offset = Vector2{ WINDOW_WIDTH / 2.0f, WINDOW_HEIGHT / 2.0f };
+    view->camera.target = Vector2{ worldWidth / 2.0f, worldHeight / 2.0f };
+    view->camera.rotation = 0.0f;
+    view->camera.zoom = view->minZoom;
+    MazeViewRefresh(view, maze);
+}
+
+void MazeViewUpdate(MazeView* view, Maze* maze) {
+    // ţǰµ걣ֲ
+    float wheel = GetMouseWheelMove();
+    if (wheel != 0.0f) {
+        Vector2 mouse = GetMousePosition();
+        Vector2 before = GetScreenToWorld2D(mouse, view->camera);
+        float zoom = view->camera.zoom * (1.0f + VIEW_ZOOM_STEP * wheel);
+        if (zoom < view->minZoom) zoom = view->minZoom;
+        if (zoom > VIEW_MAX_ZOOM) zoom = VIEW_MAX_ZOOM;
+        view->camera.zoom = zoom;
+        Vector2 after = GetScreenToWorld2D(mouse, view->camera);
+        view->camera.target.x += before.x - after.x;
+        view->camera.target.y += before.y - after.y;
+    }
+
+    // Ҽ϶ƽ
+    if (IsMouseButtonDown(MOUSE_BUTTON_RIGHT)) {
+        Vector2 delta = GetMouseDelta();
+        view->camera.target.x -= delta.x / view->camera.zoom;
+        view->camera.target.y -= delta.y / view->camera.zoom;
+    }
+
+    MazeViewRefresh(view, maze);
+}
 
 Vector2 GetCellPixelPos(Maze* maze, int x, int y) {
-    // Թƫƣʾ
-    int totalGridWidth = maze->cols * (CELL_SIZE + CELL_GAP);
-    int totalGridHeight = maze->rows * (CELL_SIZE + CELL_GAP);
-    float offsetX = (WINDOW_WIDTH - totalGridWidth) / 2.0f;
-    float offsetY = (WINDOW_HEIGHT - totalGridHeight) / 2.0f;
-
-    // 㵥꣨C++д
-    Vector2 pixelPos;
-    pixelPos.x = offsetX + x * (CELL_SIZE + CELL_GAP);
-    pixelPos.y = offsetY + y * (CELL_SIZE + CELL_GAP);
+    (void)maze;
+    Vector2 pixelPos = { (float)(x * (CELL_SIZE + CELL_GAP)), (float)(y * (CELL_SIZE + CELL_GAP)) };
     return pixelPos;
 }
 
+bool GetCellFromPixel(const MazeView* view, Maze* maze, Vector2 pixel, Point* cell) {
+    Vector2 world = GetScreenToWorld2D(pixel, view->camera);
+    if (world.x < 0.0f || world.y < 0.0f) return false;
+    cell->x = (int)(world.x / (CELL_SIZE + CELL_GAP));
+    cell->y = (int)(world.y / (CELL_SIZE + CELL_GAP));
+    return IsPointValid(maze, cell->x, cell->y);
+}
+
+// ؿȡͼ飨ͷǷʱͨ洦
+static TileSprite CellTile(CellType type) {
+    int i = type - CELL_END;
+    return (i >= 0 && i < CELL_TYPE_COUNT) ? TileForCell(type) : TILE_FLOOR;
+}
+
+// ͼCELL_SIZEСpos
+static void DrawTileAt(const MazeTextures* tex, TileSprite tile, Vector2 pos) {
+    Rectangle destRec = { pos.x, pos.y, (float)CELL_SIZE, (float)CELL_SIZE };
+    Vector2 origin = { 0.0f, 0.0f };
+    DrawTexturePro(tex->atlas, tex->rects[tile], destRec, origin, 0.0f, WHITE);
+}
+
+// ǰ׷һͼıΣ÷ѰͼrlBegin(RL_QUADS)
+static void EmitTileQuad(const MazeTextures* tex, TileSprite tile, float x, float y) {
+    const TileUV* uv = &tex->uv[tile];
+    // 㻺彫ʱύж㣬󶨵ͼԪͱֲ
+    rlCheckRenderBatchLimit(4);
+    rlTexCoord2f(uv->u0, uv->v0);
+    rlVertex2f(x, y);
+    rlTexCoord2f(uv->u0, uv->v1);
+    rlVertex2f(x, y + CELL_SIZE);
+    rlTexCoord2f(uv->u1, uv->v1);
+    rlVertex2f(x + CELL_SIZE, y + CELL_SIZE);
+    rlTexCoord2f(uv->u1, uv->v0);
+    rlVertex2f(x + CELL_SIZE, y);
+}
+
 void DrawCellWithTexture(Maze* maze, MazeTextures* tex, int x, int y, CellType type) {
-    Vector2 pos = GetCellPixelPos(maze, x, y);
-
-    // ݵؿѡ
-    Texture2D* useTex = &tex->floor; // Ĭͨ
-    if (type == CELL_START) useTex = &tex->start;
-    else if (type == CELL_END) useTex = &tex->end;
-    else if (type == CELL_WALL) useTex = &tex->wall;
-    else if (type == CELL_GRASS) useTex = &tex->grass;
-    else if (type == CELL_LAVA) useTex = &tex->lava;
-
-    // CELL_SIZEС- C++д
-    // 1. ʼԭ
-    Rectangle sourceRec;
-    sourceRec.x = 0.0f;
-    sourceRec.y = 0.0f;
-    sourceRec.width = (float)useTex->width;
-    sourceRec.height = (float)useTex->height;
-
-    // 2. ʼĿ
-    Rectangle destRec;
-    destRec.x = pos.x;
-    destRec.y = pos.y;
-    destRec.width = (float)CELL_SIZE;
-    destRec.height = (float)CELL_SIZE;
-
-    // 3. ʼת
-    Vector2 origin;
-    origin.x = 0.0f;
-    origin.y = 0.0f;
-
-    // 4. DrawTextureProȫΪC++ݵʱ
-    DrawTexturePro(
-        *useTex,
-        sourceRec,       // ԭ
-        destRec,         // Ŀ
-        origin,          // ת
-        0.0f,            // תǶ
-        WHITE            // ɫֱRaylibԤ峣ֶʼ
-    );
-}
-
-void DrawMazeGridWithTexture(Maze* maze, MazeTextures* tex) {
-    for (int y = 0; y < maze->rows; y++) {
-        for (int x = 0; x < maze->cols; x++) {
-            DrawCellWithTexture(maze, tex, x, y, maze->grid[y][x]);
+    DrawTileAt(tex, CellTile(type), GetCellPixelPos(maze, x, y));
+}
+
+void DrawSpriteOnCell(Maze* maze, MazeTextures* tex, TileSprite sprite, int x, int y) {
+    DrawTileAt(tex, sprite, GetCellPixelPos(maze, x, y));
+}
+
+// ͼÿضӦĸӱ߳ͼÿ߲OVERVIEW_MAX_SIZEأ
+static int OverviewBlockSize(const Maze* maze) {
+    int longest = maze->rows > maze->cols ? maze->rows : maze->cols;
+    return (longest + OVERVIEW_MAX_SIZE - 1) / OVERVIEW_MAX_SIZE;
+}
+
+TerrainLayer* TerrainLayerCreate(Maze* maze) {
+    TerrainLayer* layer = (TerrainLayer*)malloc(sizeof(TerrainLayer));
+    if (layer == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣβṹ");
+        return NULL;
+    }
+
+    // ȾĿֻСϸ´ڵĸӼߴԹС޹
+    const int step = CELL_SIZE + CELL_GAP;
+    int visibleX = (int)ceilf(WINDOW_WIDTH / (step * VIEW_DETAIL_MIN_ZOOM)) + 1;
+    int visibleY = (int)ceilf(WINDOW_HEIGHT / (step * VIEW_DETAIL_MIN_ZOOM)) + 1;
+    layer->capacityX = visibleX + 2 * TERRAIN_CACHE_MARGIN;
+    layer->capacityY = visibleY + 2 * TERRAIN_CACHE_MARGIN;
+    if (layer->capacityX > maze->cols) layer->capacityX = maze->cols;
+    if (layer->capacityY > maze->rows) layer->capacityY = maze->rows;
+
+    layer->target = LoadRenderTexture(layer->capacityX * step, layer->capacityY * step);
+    if (layer->target.id == 0) {
+        TraceLog(LOG_ERROR, "βȾʧܣ%d %dУ", layer->capacityY, layer->capacityX);
+        free(layer);
+        return NULL;
+    }
+    layer->firstX = 0;
+    layer->firstY = 0;
+    layer->lastX = -1;
+    layer->lastY = -1;
+    layer->dirtyCount = 0;
+    layer->fullRedraw = true;
+    layer->redrawnCells = 0;
+
+    layer->overview.id = 0;
+    layer->overviewPixels = NULL;
+    layer->overviewBlock = OverviewBlockSize(maze);
+    layer->overviewDirty = DirtyRect{ 0, 0, -1, -1 };
+    return layer;
+}
+
+void TerrainLayerDestroy(TerrainLayer* layer) {
+    if (layer == NULL) return;
+    UnloadRenderTexture(layer->target);
+    if (layer->overview.id != 0) UnloadTexture(layer->overview);
+    free(layer->overviewPixels);
+    free(layer);
+}
+
+// һ㲢ΣΪʱΪõ㣩
+static void DirtyRectInclude(DirtyRect* r, int x, int y) {
+    if (r->x0 > r->x1) {
+        *r = DirtyRect{ x, y, x, y };
+        return;
+    }
+    if (x < r->x0) r->x0 = x;
+    if (x > r->x1) r->x1 = x;
+    if (y < r->y0) r->y0 = y;
+    if (y > r->y1) r->y1 = y;
+}
+
+void TerrainLayerMarkDirty(TerrainLayer* layer, int x, int y) {
+    // ͼʱ¶Ӧأлͼʱٸ
+    if (layer->overviewPixels != NULL) {
+        DirtyRectInclude(&layer->overviewDirty, x / layer->overviewBlock, y / layer->overviewBlock);
+    }
+
+    if (layer->fullRedraw) return;
+    if (x < layer->firstX || x > layer->lastX || y < layer->firstY || y > layer->lastY) return;
+
+    // صڵκϲ޸ĵһƬֻռһ
+    for (int i = 0; i < layer->dirtyCount; i++) {
+        DirtyRect* r = &layer->dirty[i];
+        if (x < r->x0 - 1 || x > r->x1 + 1 || y < r->y0 - 1 || y > r->y1 + 1) continue;
+        DirtyRectInclude(r, x, y);
+        return;
+    }
+    if (layer->dirtyCount == TERRAIN_MAX_DIRTY) {
+        layer->fullRedraw = true;
+        return;
+    }
+    DirtyRect r = { x, y, x, y };
+    layer->dirty[layer->dirtyCount++] = r;
+}
+
+void TerrainLayerMarkAll(TerrainLayer* layer) {
+    layer->fullRedraw = true;
+    // ½ڸʱüͼߴ
+    if (layer->overviewPixels != NULL) layer->overviewDirty = DirtyRect{ 0, 0, INT_MAX, INT_MAX };
+}
+
+// ͼһصɫӦӿƽɫ
+static Color OverviewBlockColor(Maze* maze, int block, int px, int py) {
+    int x0 = px * block;
+    int y0 = py * block;
+    int x1 = x0 + block < maze->cols ? x0 + block : maze->cols;
+    int y1 = y0 + block < maze->rows ? y0 + block : maze->rows;
+    unsigned int r = 0, g = 0, b = 0;
+    for (int y = y0; y < y1; y++) {
+        const signed char* row = maze->grid + MazeIndex(maze, 0, y);
+        for (int x = x0; x < x1; x++) {
+            Color c = OVERVIEW_COLORS[TileForCell((CellType)row[x])];
+            r += c.r;
+            g += c.g;
+            b += c.b;
+        }
+    }
+    unsigned int n = (unsigned int)((x1 - x0) * (y1 - y0));
+    Color c = { (unsigned char)(r / n), (unsigned char)(g / n), (unsigned char)(b / n), 255 };
+    return c;
+}
+
+// ɻֲͼ״εʱɣֻ֮ǹУ
+static void TerrainLayerUpdateOverview(TerrainLayer* layer, Maze* maze) {
+    int block = layer->overviewBlock;
+    int width = (maze->cols + block - 1) / block;
+    int height = (maze->rows + block - 1) / block;
+    if (layer->overviewPixels == NULL) {
+        layer->overviewPixels = (Color*)malloc((size_t)width * height * sizeof(Color));
+        if (layer->overviewPixels == NULL) {
+            TraceLog(LOG_ERROR, "ڴʧܣͼ%dx%d", width, height);
+            return;
+        }
+        layer->overviewDirty = DirtyRect{ 0, 0, width - 1, height - 1 };
+    }
+
+    DirtyRect* r = &layer->overviewDirty;
+    if (r->x0 > r->x1) return;
+    if (r->x1 > width - 1) r->x1 = width - 1;
+    if (r->y1 > height - 1) r->y1 = height - 1;
+    for (int py = r->y0; py <= r->y1; py++) {
+        for (int px = r->x0; px <= r->x1; px++) {
+            layer->overviewPixels[(size_t)py * width + px] = OverviewBlockColor(maze, block, px, py);
+        }
+    }
+
+    if (layer->overview.id == 0) {
+        Image image = { layer->overviewPixels, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        layer->overview = LoadTextureFromImage(image);
+    }
+    else {
+        // ϴCPU
+        Rectangle rows = { 0.0f, (float)r->y0, (float)width, (float)(r->y1 - r->y0 + 1) };
+        UpdateTextureRec(layer->overview, rows, layer->overviewPixels + (size_t)r->y0 * width);
+    }
+    *r = DirtyRect{ 0, 0, -1, -1 };
+}
+
+// һ򣨸䣩ͼ׷ӵǰ
+static void EmitTileRect(TerrainLayer* layer, Maze* maze, const MazeTextures* tex, const DirtyRect* r) {
+    const int step = CELL_SIZE + CELL_GAP;
+    for (int y = r->y0; y <= r->y1; y++) {
+        // ˳ȡ洢
+        const signed char* row = maze->grid + MazeIndex(maze, 0, y);
+        float px = (float)((r->x0 - layer->firstX) * step);
+        float py = (float)((y - layer->firstY) * step);
+        for (int x = r->x0; x <= r->x1; x++) {
+            EmitTileQuad(tex, CellTile((CellType)row[x]), px, py);
+            px += step;
+        }
+    }
+    layer->redrawnCells += (r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+void TerrainLayerUpdate(TerrainLayer* layer, Maze* maze, MazeTextures* tex, const MazeView* view) {
+    layer->redrawnCells = 0;
+    if (view->overview) {
+        TerrainLayerUpdateOverview(layer, maze);
+        return;
+    }
+    if (view->lastX < view->firstX || view->lastY < view->firstY) return;
+
+    // ɼΧƳѻ淶ΧʱԿɼΧΪѡȡ淶Χػ
+    if (view->firstX < layer->firstX || view->lastX > layer->lastX || view->firstY < layer->firstY || view->lastY > layer->lastY) {
+        int x0 = view->firstX - TERRAIN_CACHE_MARGIN;
+        int y0 = view->firstY - TERRAIN_CACHE_MARGIN;
+        if (x0 > maze->cols - layer->capacityX) x0 = maze->cols - layer->capacityX;
+        if (y0 > maze->rows - layer->capacityY) y0 = maze->rows - layer->capacityY;
+        if (x0 < 0) x0 = 0;
+        if (y0 < 0) y0 = 0;
+        layer->firstX = x0;
+        layer->firstY = y0;
+        layer->lastX = x0 + layer->capacityX - 1;
+        layer->lastY = y0 + layer->capacityY - 1;
+        layer->fullRedraw = true;
+    }
+    if (!layer->fullRedraw && layer->dirtyCount == 0) return;
+
+    const int step = CELL_SIZE + CELL_GAP;
+    BeginTextureMode(layer->target);
+    if (layer->fullRedraw) {
+        ClearBackground(COLOR_BACKGROUND);
+        DirtyRect all = { layer->firstX, layer->firstY, layer->lastX, layer->lastY };
+        layer->dirty[0] = all;
+        layer->dirtyCount = 1;
+    }
+    else {
+        // ͼܴ͸أñɫǸΣ϶
+        for (int i = 0; i < layer->dirtyCount; i++) {
+            const DirtyRect* r = &layer->dirty[i];
+            DrawRectangle((r->x0 - layer->firstX) * step, (r->y0 - layer->firstY) * step,
+                (r->x1 - r->x0 + 1) * step, (r->y1 - r->y0 + 1) * step, COLOR_BACKGROUND);
+        }
+    }
+
+    // ͼȡͬһͼȫΪһύ
+    rlSetTexture(tex->atlas.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(255, 255, 255, 255);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (int i = 0; i < layer->dirtyCount; i++) {
+        EmitTileRect(layer, maze, tex, &layer->dirty[i]);
+    }
+    rlEnd();
+    rlSetTexture(0);
+    EndTextureMode();
+
+    layer->dirtyCount = 0;
+    layer->fullRedraw = false;
+}
+
+void DrawTerrainLayer(const TerrainLayer* layer, Maze* maze, const MazeView* view) {
+    const int step = CELL_SIZE + CELL_GAP;
+    Vector2 origin = { 0.0f, 0.0f };
+    if (view->overview) {
+        // ͼ쵽Թ귶Χ
+        if (layer->overview.id == 0) return;
+        Rectangle sourceRec = { 0.0f, 0.0f, (float)layer->overview.width, (float)layer->overview.height };
+        Rectangle destRec = { 0.0f, 0.0f, (float)(maze->cols * step), (float)(maze->rows * step) };
+        DrawTexturePro(layer->overview, sourceRec, destRec, origin, 0.0f, WHITE);
+        return;
+    }
+    if (layer->lastX < layer->firstX) return;
+
+    // ȾOpenGLµߵ洢ѻλײԴ߶ȡֵת
+    float usedWidth = (float)((layer->lastX - layer->firstX + 1) * step);
+    float usedHeight = (float)((layer->lastY - layer->firstY + 1) * step);
+    Rectangle sourceRec = { 0.0f, layer->target.texture.height - usedHeight, usedWidth, -usedHeight };
+    DrawTextureRec(layer->target.texture, sourceRec, GetCellPixelPos(maze, layer->firstX, layer->firstY), WHITE);
+}
+
+PathLayer* PathLayerCreate(Maze* maze) {
+    PathLayer* layer = (PathLayer*)malloc(sizeof(PathLayer));
+    if (layer == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ·ṹ");
+        return NULL;
+    }
+    layer->source = NULL;
+    layer->revision = 0;
+    layer->segments = NULL;
+    layer->segmentCount = 0;
+    layer->segmentCapacity = 0;
+    layer->overview.id = 0;
+    layer->overviewPixels = NULL;
+    layer->overviewBlock = OverviewBlockSize(maze);
+    layer->overviewStale = true;
+    return layer;
+}
+
+void PathLayerDestroy(PathLayer* layer) {
+    if (layer == NULL) return;
+    free(layer->segments);
+    if (layer->overview.id != 0) UnloadTexture(layer->overview);
+    free(layer->overviewPixels);
+    free(layer);
+}
+
+// ·гÿPATH_SEGMENT_STEPS񣬼¶׵ĵ״̬ΧУ·仯һΣ
+static void PathLayerRebuild(PathLayer* layer, const MazePath* path) {
+    layer->source = path;
+    layer->revision = path->revision;
+    layer->segmentCount = 0;
+    layer->overviewStale = true;
+
+    MazePathIter it;
+    MazePathIterBegin(&it, path);
+    for (;;) {
+        PathSegment segment;
+        segment.begin = it;
+        segment.bounds = DirtyRect{ 0, 0, -1, -1 };
+        int n = 0;
+        Point p;
+        while (n < PATH_SEGMENT_STEPS && MazePathIterNext(&it, &p)) {
+            DirtyRectInclude(&segment.bounds, p.x, p.y);
+            n++;
+        }
+        if (n == 0) return;
+        if (layer->segmentCount == layer->segmentCapacity) {
+            int capacity = layer->segmentCapacity > 0 ? layer->segmentCapacity * 2 : 64;
+            PathSegment* grown = (PathSegment*)realloc(layer->segments, (size_t)capacity * sizeof(PathSegment));
+            if (grown == NULL) {
+                TraceLog(LOG_ERROR, "ڴʧܣ·Σ%dΣ", capacity);
+                return;
+            }
+            layer->segments = grown;
+            layer->segmentCapacity = capacity;
+        }
+        layer->segments[layer->segmentCount++] = segment;
+        if (n < PATH_SEGMENT_STEPS) return;
+    }
+}
+
+// ػ·ͼ·ĸӿͿ·ɫ͸
+static void PathLayerUpdateOverview(PathLayer* layer, Maze* maze, const MazePath* path) {
+    int block = layer->overviewBlock;
+    int width = (maze->cols + block - 1) / block;
+    int height = (maze->rows + block - 1) / block;
+    if (layer->overviewPixels == NULL) {
+        layer->overviewPixels = (Color*)malloc((size_t)width * height * sizeof(Color));
+        if (layer->overviewPixels == NULL) {
+            TraceLog(LOG_ERROR, "ڴʧܣ·ͼ%dx%d", width, height);
+            return;
+        }
+    }
+    memset(layer->overviewPixels, 0, (size_t)width * height * sizeof(Color));
+    MazePathIter it;
+    MazePathIterBegin(&it, path);
+    Point p;
+    while (MazePathIterNext(&it, &p)) {
+        layer->overviewPixels[(size_t)(p.y / block) * width + p.x / block] = COLOR_PATH;
+    }
+
+    if (layer->overview.id == 0) {
+        Image image = { layer->overviewPixels, width, height, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        layer->overview = LoadTextureFromImage(image);
+    }
+    else {
+        UpdateTexture(layer->overview, layer->overviewPixels);
+    }
+    layer->overviewStale = false;
+}
+
+void DrawPathOnTexture(PathLayer* layer, Maze* maze, const MazeView* view, const MazePath* path) {
+    if (layer->source != path || layer->revision != path->revision) PathLayerRebuild(layer, path);
+
+    if (view->overview) {
+        if (layer->overviewStale) PathLayerUpdateOverview(layer, maze, path);
+        if (layer->overview.id == 0) return;
+        const int step = CELL_SIZE + CELL_GAP;
+        Rectangle sourceRec = { 0.0f, 0.0f, (float)layer->overview.width, (float)layer->overview.height };
+        Rectangle destRec = { 0.0f, 0.0f, (float)(maze->cols * step), (float)(maze->rows * step) };
+        DrawTexturePro(layer->overview, sourceRec, destRec, Vector2{ 0.0f, 0.0f }, 0.0f, WHITE);
+        return;
+    }
+
+    for (int s = 0; s < layer->segmentCount; s++) {
+        const PathSegment* segment = &layer->segments[s];
+        const DirtyRect* b = &segment->bounds;
+        // ΧɼΧཻĶ
+        if (b->x1 < view->firstX || b->x0 > view->lastX || b->y1 < view->firstY || b->y0 > view->lastY) continue;
+        MazePathIter it = segment->begin;
+        Point p;
+        for (int n = 0; n < PATH_SEGMENT_STEPS && MazePathIterNext(&it, &p); n++) {
+            if (!MazeViewCellVisible(view, p.x, p.y)) continue;
+            // յ㣨ԭ
+            CellType cell = MazeGetCell(maze, p.x, p.y);
+            if (cell == CELL_START || cell == CELL_END) continue;
+            Vector2 pos = GetCellPixelPos(maze, p.x, p.y);
+            // ư͸ɫ·ϣ
+            DrawRectangle((int)pos.x, (int)pos.y, CELL_SIZE, CELL_SIZE, COLOR_PATH);
         }
     }
 }
 
-void DrawPathOnTexture(Maze* maze, Point* path, int pathLen) {
-    for (int i = 0; i < pathLen; i++) {
-        int x = path[i].x;
-        int y = path[i].y;
-        // յ㣨ԭ
-        if (maze->grid[y][x] == CELL_START || maze->grid[y][x] == CELL_END) continue;
+void DrawSearchProgress(Maze* maze, const MazeView* view, const MazeSearch* search) {
+    if (search->status == SEARCH_IDLE) return;
+    const int* frontier = NULL;
+    int count = MazeSearchFrontier(search, &frontier);
+    int first = count > FRONTIER_DRAW_LIMIT ? count - FRONTIER_DRAW_LIMIT : 0;
+
+    if (view->overview) {
+        // ɼΧŴԹɨѷʼϵĿԹСȣֻǰأÿŴΪͼһ
+        const int step = CELL_SIZE + CELL_GAP;
+        int block = OverviewBlockSize(maze);
+        for (int i = first; i < count; i++) {
+            Point p = MazePointFromIndex(maze, frontier[i]);
+            DrawRectangle(p.x / block * block * step, p.y / block * block * step, block * step, block * step, COLOR_FRONTIER);
+        }
+        return;
+    }
+
+    // ѷʼϣɨɼΧϸ¿ɼޣ
+    for (int y = view->firstY; y <= view->lastY; y++) {
+        for (int x = view->firstX; x <= view->lastX; x++) {
+            if (!MazeSearchVisited(search, MazeIndex(maze, x, y))) continue;
+            Vector2 pos = GetCellPixelPos(maze, x, y);
+            DrawRectangle((int)pos.x, (int)pos.y, CELL_SIZE, CELL_SIZE, COLOR_VISITED);
+        }
+    }
+
+    // ǰصѷʼ֮
+    for (int i = first; i < count; i++) {
+        Point p = MazePointFromIndex(maze, frontier[i]);
+        if (!MazeViewCellVisible(view, p.x, p.y)) continue;
+        Vector2 pos = GetCellPixelPos(maze, p.x, p.y);
+        DrawRectangle((int)pos.x, (int)pos.y, CELL_SIZE, CELL_SIZE, COLOR_FRONTIER);
+    }
+}
 
-        Vector2 pos = GetCellPixelPos(maze, x, y);
-        // ư͸ɫ·ϣ
-        DrawRectangle(
-            (int)pos.x, (int)pos.y,
-            CELL_SIZE, CELL_SIZE,
-            COLOR_PATH  // ֱú궨壬ֶʼColor
-        );
+void DrawCrowd(const Crowd* crowd, MazeTextures* tex, const MazeView* view) {
+    if (crowd->count == 0) return;
+    const float step = (float)(CELL_SIZE + CELL_GAP);
+    // (x+0.5)ӦϽx*stepλüȥΪϽ
+    rlSetTexture(tex->atlas.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(255, 255, 255, 255);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (int i = 0; i < crowd->count; i++) {
+        float x = crowd->posX[i];
+        float y = crowd->posY[i];
+        if (!MazeViewCellVisible(view, (int)x, (int)y)) continue;
+        EmitTileQuad(tex, TILE_SLIME, (x - 0.5f) * step, (y - 0.5f) * step);
     }
+    rlEnd();
+    rlSetTexture(0);
 }
\ No newline at end of file
@@ -4,14 +4,121 @@
 
 #include "maze_config.h"
 #include "maze_textures.h"
+#include "maze_utils.h"
+#include "maze_search.h"
+#include "maze_crowd.h"
 
-// ȡ
+// ͼãи(x, y)Ͻλ(x, y) * (CELL_SIZE + CELL_GAP)Camera2Dƽŵ
+constexpr float VIEW_MAX_ZOOM = 4.0f;         // Ŵ
+constexpr float VIEW_DETAIL_MIN_ZOOM = 0.5f;  // ڸʱͼ
+constexpr float VIEW_ZOOM_STEP = 0.1f;        // ÿű
+constexpr int OVERVIEW_MAX_SIZE = 1024;       // ͼÿߵʱȡƽɫ
+constexpr int TERRAIN_CACHE_MARGIN = 4;       // βڿɼΧ໺ĸСƽƲػ棩
+constexpr int FRONTIER_DRAW_LIMIT = 4096;     // ÿ֡Ƶǰظȡ¼Ĳ֣
+
+// ͼ
+typedef struct {
+    Camera2D camera;     // targetΪĶӦ꣩
+    float minZoom;       // СţԹʾ
+    int firstX, firstY;  // ɼΧϽǸ
+    int lastX, lastY;    // ɼΧ½ǸӣԹڴʱСfirst
+    bool overview;       // ǰǷͼ
+} MazeView;
+
+// ԹߴʼͼУԹɼҲ1
+void MazeViewInit(MazeView* view, Maze* maze);
+// ţΪģҼ϶ƽƣ¿ɼΧ
+void MazeViewUpdate(MazeView* view, Maze* maze);
+// ǷڿɼΧ
+inline bool MazeViewCellVisible(const MazeView* view, int x, int y) {
+    return x >= view->firstX && x <= view->lastX && y >= view->firstY && y <= view->lastY;
+}
+
+// ȡ꣨ʱ账BeginMode2DУ
 Vector2 GetCellPixelPos(Maze* maze, int x, int y);
-// Ƶؿ飨棩
+// Ƶؿ飨ͼȡͼ飩
 void DrawCellWithTexture(Maze* maze, MazeTextures* tex, int x, int y, CellType type);
-// Թ
-void DrawMazeGridWithTexture(Maze* maze, MazeTextures* tex);
-// ·ϣ
-void DrawPathOnTexture(Maze* maze, Point* path, int pathLen);
+// ת꣨ԹΧڷfalse
+bool GetCellFromPixel(const MazeView* view, Maze* maze, Vector2 pixel, Point* cell);
+// ڷϻƾ飨ɫ˵ȣͼȡͼ鲢С
+void DrawSpriteOnCell(Maze* maze, MazeTextures* tex, TileSprite sprite, int x, int y);
+
+// ̬β㣺ɼΧĵԤȾһRenderTexture2Dÿֻ֡һ
+// ؿ仯ʱӼ¼Σ´θֻػЩͼƳ淶Χʱػ档
+// СVIEW_DETAIL_MIN_ZOOMʱΪԹͼÿһһӵƽɫ
+// ·ɫ֡ϡ
+constexpr int TERRAIN_MAX_DIRTY = 32;  // ޣʱػ棩
+
+// Σ꣬䣩
+typedef struct {
+    int x0, y0;
+    int x1, y1;
+} DirtyRect;
+
+// β㻺
+typedef struct {
+    RenderTexture2D target;  // βȾĿ꣨ߴ簴СϸµĿɼһη䣩
+    int capacityX;           // ȾĿɵ
+    int capacityY;           // ȾĿɵ
+    int firstX, firstY;      // ѻ淶ΧϽǸ
+    int lastX, lastY;        // ѻ淶Χ½ǸӣСfirstʾδ棩
+    DirtyRect dirty[TERRAIN_MAX_DIRTY]; // ػ
+    int dirtyCount;          // 
+    bool fullRedraw;         // ´θʱػ
+    int redrawnCells;        // һθػĸ
+    Texture2D overview;      // ͼ״Ҫʱɣ
+    Color* overviewPixels;   // ͼأCPU޸ĵؿʱֲ£
+    int overviewBlock;       // ͼÿضӦĸӱ߳
+    DirtyRect overviewDirty; // ͼµطΧx0>x1ʾûУ
+} TerrainLayer;
+
+// β㣨InitWindow֮ãԹߴ仯ʱ´
+TerrainLayer* TerrainLayerCreate(Maze* maze);
+// ͷŵβ
+void TerrainLayerDestroy(TerrainLayer* layer);
+// ǸҪػ棨ڵκϲ
+void TerrainLayerMarkDirty(TerrainLayer* layer, int x, int y);
+// Ҫػ
+void TerrainLayerMarkAll(TerrainLayer* layer);
+// ͼµβ㣨BeginDrawing֮ǰãȫͼΪһͼύûб仯ʱκ£
+void TerrainLayerUpdate(TerrainLayer* layer, Maze* maze, MazeTextures* tex, const MazeView* view);
+// Ƶβ㣨账BeginMode2DУһƣԹС޹أ
+void DrawTerrainLayer(const TerrainLayer* layer, Maze* maze, const MazeView* view);
+
+// ·㣺·仯ʱMazePath޶жϣ·̶жβ¸εİΧУ
+// ֻ֡չɼΧཻĶΣƿȡڿɼǲ··ĳȺԹС޹ء
+// ͼ¸Ϊͼֱͬʵ͸·仯״ҪʱػһΡ
+constexpr int PATH_SEGMENT_STEPS = 256;  // ÿεĸ
+
+// ·
+typedef struct {
+    MazePathIter begin;  // ׵ĵ״̬ȡεĸӣ
+    DirtyRect bounds;    // θӵİΧ
+} PathSegment;
+
+// ·㻺
+typedef struct {
+    const MazePath* source;  // жε·NULLʾδжΣ
+    unsigned int revision;   // жʱ·޶
+    PathSegment* segments;   // ·
+    int segmentCount;
+    int segmentCapacity;
+    Texture2D overview;      // ·ͼ͸ף״Ҫʱɣ
+    Color* overviewPixels;   // ·ͼأCPU
+    int overviewBlock;       // ͼÿضӦĸӱ߳βһ£
+    bool overviewStale;      // ·仯ͼδػ
+} PathLayer;
+
+// ·㣨InitWindow֮ãԹߴ仯ʱ´
+PathLayer* PathLayerCreate(Maze* maze);
+// ͷ·
+void PathLayerDestroy(PathLayer* layer);
+// ·账BeginMode2DУϸֻչɼΧཻ·Σͼ»һ
+void DrawPathOnTexture(PathLayer* layer, Maze* maze, const MazeView* view, const MazePath* path);
+// ƷֲĽȣѷʸǰأֻƿɼΧڵĸӣǰFRONTIER_DRAW_LIMIT
+// ͼ²ɨѷʼϣֻͼĿСǰ
+void DrawSearchProgress(Maze* maze, const MazeView* view, const MazeSearch* search);
+// ʷķȺ壨пɼΪһͼύλڸλã
+void DrawCrowd(const Crowd* crowd, MazeTextures* tex, const MazeView* view);
 
 #endif // MAZE_RENDER_H
\ No newline at end of file
@@ -0,0 +1,264 @@
+#include "maze_search.h"
+#include <chrono>
+
+// ĸңmaze_algorithms.cppһ
+static const int DIR_DX[4] = { 0, 0, -1, 1 };
+static const int DIR_DY[4] = { -1, 1, 0, 0 };
+
+// A*ĶѼֵfСȣfͬʱgȣAStarһ£
+static long long SearchAStarKey(int f, int g) {
+    return ((long long)f << 31) | (long long)(INT_MAX - g);
+}
+
+// A*ֵپСɱ
+static int SearchHeuristic(const MazeSearch* s, int x, int y) {
+    return (abs(x - s->maze->end.x) + abs(y - s->maze->end.y)) * s->minCost;
+}
+
+bool MazeSearchSupports(MazeAlgorithm algo) {
+    switch (algo) {
+    case ALGO_DFS:
+    case ALGO_BFS:
+    case ALGO_DIJKSTRA:
+    case ALGO_DIJKSTRA_BUCKET:
+    case ALGO_DIJKSTRA_HEAP:
+    case ALGO_ASTAR:
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool MazeSearchBegin(MazeSearch* search, Maze* maze, PathData* pd, MazeAlgorithm algo, const int* costTable) {
+    search->maze = maze;
+    search->pd = pd;
+    search->algo = algo;
+    search->costTable = costTable;
+    search->status = SEARCH_IDLE;
+    search->front = 0;
+    search->rear = 0;
+    search->top = -1;
+    search->open = NULL;
+    search->steps = 0;
+    search->seconds = 0.0;
+    if (!MazeSearchSupports(algo)) {
+        TraceLog(LOG_WARNING, "%sֲִַ֧", MazeAlgorithmName(algo));
+        return false;
+    }
+
+    PathDataReset(pd);
+    search->startIndex = MazeIndex(maze, maze->start.x, maze->start.y);
+    search->endIndex = MazeIndex(maze, maze->end.x, maze->end.y);
+    search->minCost = INT_MAX;
+    for (int t = 0; t < CELL_TYPE_COUNT; t++) {
+        if (costTable[t] != COST_IMPASSABLE && costTable[t] < search->minCost) search->minCost = costTable[t];
+    }
+    if (search->minCost == INT_MAX) search->minCost = 0;
+
+    // MazeSolveWithһ£յ㲻ͬһͨʱֱӽ֡չɴ
+    if (!MazeEndpointsConnected(maze, pd)) {
+        search->status = SEARCH_NOT_FOUND;
+        TraceLog(LOG_WARNING, "%s㷨δҵɴ·յ㲻ͬһͨ", MazeAlgorithmName(algo));
+        return true;
+    }
+
+    if (algo == ALGO_DFS || algo == ALGO_BFS) {
+        if (!PathDataReserveQueue(pd)) return false;
+        PathDataSet(pd, search->startIndex, 0, -1);
+        if (algo == ALGO_DFS) {
+            // DFSһ£㼴յֱӳɹǽֱʧ
+            search->status = SEARCH_RUNNING;
+            if (search->startIndex == search->endIndex) search->status = SEARCH_FOUND;
+            else if (maze->grid[search->startIndex] == CELL_WALL) search->status = SEARCH_NOT_FOUND;
+            search->top = 0;
+            pd->queue[0] = search->startIndex;
+            pd->dirStack[0] = 0;
+            PathDataStatPush(pd, 1);
+            pd->expanded++;
+            return true;
+        }
+        pd->queue[search->rear++] = search->startIndex;
+        PathDataStatPush(pd, 1);
+    }
+    else {
+        search->open = PathDataHeap(pd);
+        if (search->open == NULL) return false;
+        PathDataSet(pd, search->startIndex, 0, -1);
+        long long key = 0;
+        if (algo == ALGO_ASTAR) key = SearchAStarKey(SearchHeuristic(search, maze->start.x, maze->start.y), 0);
+        IndexedHeapPush(search->open, search->startIndex, key);
+        PathDataStatPush(pd, 1);
+    }
+    search->status = SEARCH_RUNNING;
+    return true;
+}
+
+// DFSÿִеջһһһΣ
+static const int SEARCH_DFS_MAX_OPS = 64;
+
+// DFSƽһջӵһDFSĳ˳һ£
+static void SearchStepDfs(MazeSearch* s) {
+    Maze* maze = s->maze;
+    PathData* pd = s->pd;
+    int* stack = pd->queue;
+    unsigned char* nextDir = pd->dirStack;
+    // ݺܳ·ʱҲҪʱ÷Ԥ㣺ջﵽ޼أ״̬Ϊ
+    for (int ops = 0; s->top >= 0; ops++) {
+        if (ops == SEARCH_DFS_MAX_OPS) return;
+        if (nextDir[s->top] == 4) {
+            PathDataStatPop(pd);
+            s->top--; // ĸѳԣ
+            continue;
+        }
+        int u = stack[s->top];
+        int dir = nextDir[s->top]++;
+        int nx = u % maze->cols + DIR_DX[dir];
+        int ny = u / maze->cols + DIR_DY[dir];
+        if (!IsPointValid(maze, nx, ny)) continue;
+        int v = MazeIndex(maze, nx, ny);
+        PathDataStatRelax(pd);
+        if (v == s->endIndex) {
+            PathDataSet(pd, v, pd->distance[u] + 1, u);
+            s->status = SEARCH_FOUND;
+            return;
+        }
+        if (PathDataSeen(pd, v) || maze->grid[v] == CELL_WALL) continue;
+
+        // ̽һһ
+        PathDataSet(pd, v, pd->distance[u] + 1, u);
+        pd->expanded++;
+        s->top++;
+        stack[s->top] = v;
+        nextDir[s->top] = 0;
+        PathDataStatPush(pd, s->top + 1);
+        return;
+    }
+    s->status = SEARCH_NOT_FOUND;
+}
+
+// BFSƽһһӲھ
+static void SearchStepBfs(MazeSearch* s) {
+    Maze* maze = s->maze;
+    PathData* pd = s->pd;
+    if (s->front == s->rear) {
+        s->status = SEARCH_NOT_FOUND;
+        return;
+    }
+    int u = pd->queue[s->front++];
+    PathDataStatPop(pd);
+    pd->expanded++;
+    if (u == s->endIndex) {
+        s->status = SEARCH_FOUND;
+        return;
+    }
+
+    int ux = u % maze->cols;
+    int uy = u / maze->cols;
+    int du = pd->distance[u];
+    for (int i = 0; i < 4; i++) {
+        int nx = ux + DIR_DX[i];
+        int ny = uy + DIR_DY[i];
+        if (!IsPointValid(maze, nx, ny)) continue;
+        int v = MazeIndex(maze, nx, ny);
+        PathDataStatRelax(pd);
+        if (!PathDataSeen(pd, v) && maze->grid[v] != CELL_WALL) {
+            PathDataSet(pd, v, du + 1, u);
+            pd->queue[s->rear++] = v;
+            PathDataStatPush(pd, s->rear - s->front);
+        }
+    }
+}
+
+// Dijkstra/A*ƽһбмֵСĸӲɳھ
+static void SearchStepBest(MazeSearch* s) {
+    Maze* maze = s->maze;
+    PathData* pd = s->pd;
+    if (s->open->size == 0) {
+        s->status = SEARCH_NOT_FOUND;
+        return;
+    }
+    int u = IndexedHeapPop(s->open);
+    PathDataClose(pd, u);
+    PathDataStatPop(pd);
+    pd->expanded++;
+    if (u == s->endIndex) {
+        s->status = SEARCH_FOUND;
+        return;
+    }
+
+    int ux = u % maze->cols;
+    int uy = u / maze->cols;
+    int du = pd->distance[u];
+    for (int i = 0; i < 4; i++) {
+        int nx = ux + DIR_DX[i];
+        int ny = uy + DIR_DY[i];
+        if (!IsPointValid(maze, nx, ny)) continue;
+        int v = MazeIndex(maze, nx, ny);
+        PathDataStatRelax(pd);
+        if (PathDataClosed(pd, v)) continue;
+        int cost = TerrainCost(s->costTable, (CellType)maze->grid[v]);
+        if (cost == COST_IMPASSABLE) continue;
+
+        int nd = du + cost;
+        if (nd < PathDataDistance(pd, v)) {
+            PathDataSet(pd, v, nd, u);
+            long long key = nd;
+            if (s->algo == ALGO_ASTAR) key = SearchAStarKey(nd + SearchHeuristic(s, nx, ny), nd);
+            IndexedHeapPush(s->open, v, key);
+            PathDataStatPush(pd, s->open->size);
+        }
+    }
+}
+
+MazeSearchStatus MazeSearchStep(MazeSearch* search, int maxNodes, double maxSeconds) {
+    if (search->status != SEARCH_RUNNING) return search->status;
+
+    // ʱÿ64ڵһΣƵʱ
+    auto begin = std::chrono::steady_clock::now();
+    double elapsed = 0.0;
+    for (int n = 0; maxNodes <= 0 || n < maxNodes; n++) {
+        if (search->algo == ALGO_DFS) SearchStepDfs(search);
+        else if (search->algo == ALGO_BFS) SearchStepBfs(search);
+        else SearchStepBest(search);
+        if (search->status != SEARCH_RUNNING) break;
+        if (maxSeconds > 0.0 && (n & 63) == 63) {
+            elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            if (elapsed >= maxSeconds) break;
+        }
+    }
+    search->seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    search->steps++;
+#if MAZE_STATS
+    search->pd->stats.milliseconds = search->seconds * 1000.0;
+#endif
+
+    if (search->status == SEARCH_FOUND) {
+        TraceLog(LOG_INFO, "%sֲɣ·ɱ%dչڵ%dƽ%dΣʱ%.2fms", MazeAlgorithmName(search->algo),
+            search->pd->distance[search->endIndex], search->pd->expanded, search->steps, search->seconds * 1000.0);
+    }
+    else if (search->status == SEARCH_NOT_FOUND) {
+        TraceLog(LOG_WARNING, "%sֲδҵɴ·", MazeAlgorithmName(search->algo));
+    }
+    return search->status;
+}
+
+void MazeSearchStop(MazeSearch* search) {
+    search->status = SEARCH_IDLE;
+}
+
+int MazeSearchFrontier(const MazeSearch* search, const int** cells) {
+    if (search->status == SEARCH_IDLE) {
+        *cells = NULL;
+        return 0;
+    }
+    if (search->algo == ALGO_DFS) {
+        *cells = search->pd->queue;
+        return search->top + 1;
+    }
+    if (search->algo == ALGO_BFS) {
+        *cells = search->pd->queue + search->front;
+        return search->rear - search->front;
+    }
+    *cells = search->open->heap;
+    return search->open->size;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef MAZE_SEARCH_H
+#define MAZE_SEARCH_H
+
+#include "maze_config.h"
+#include "maze_utils.h"
+#include "maze_algorithms.h"
+
+// ɷֲִеDFSBFSDijkstraA*дΪɻָ״̬ÿεðڵʱԤƽ󷵻أ
+// ״̬ȫMazeSearchPathDataУһεôжϴ
+// Ⱦ߳ÿ֡ƽһμɱʾѷʼǰأ֡ʱԤԹС޹أ
+// Ԥ㲻ʱһеף⡣
+// DijkstraͳһѰִУԹ޸ģ޸ĺBegin
+
+// ״̬
+typedef enum {
+    SEARCH_IDLE = 0,    // δʼֹͣ
+    SEARCH_RUNNING,     // 
+    SEARCH_FOUND,       // ҵ·PathBacktrackݣ
+    SEARCH_NOT_FOUND    // ѽ·
+} MazeSearchStatus;
+
+// ֲ
+typedef struct {
+    Maze* maze;               // Թ
+    PathData* pd;             // 롢ڵʱǣ
+    MazeAlgorithm algo;       // 㷨
+    const int* costTable;     // γɱ
+    MazeSearchStatus status;  // ǰ״̬
+    int startIndex;           // ±
+    int endIndex;             // յ±
+    int minCost;              // A*ʹõСɱ
+    int front;                // BFSͷΪpd->queue[front, rear)
+    int rear;                 // BFSβ
+    int top;                  // DFSջջΪpd->queue[0, top]-1ʾգ
+    IndexedHeap* open;        // Dijkstra/A*ĿбȡԹ
+    int steps;                // ƽĴ
+    double seconds;           // ۼƽʱ룩
+} MazeSearch;
+
+// 㷨Ƿֲִַ֧
+bool MazeSearchSupports(MazeAlgorithm algo);
+// ʼµķֲùͨԤ죬յ㲻ͨʱ״ֱ̬ΪSEARCH_NOT_FOUND
+// ֵ֧㷨ڴ治ʱfalse
+bool MazeSearchBegin(MazeSearch* search, Maze* maze, PathData* pd, MazeAlgorithm algo, const int* costTable);
+// ƽչmaxNodesڵʱmaxSeconds루<=0ʾޣƽ״̬
+// DFSʱÿ64ջҲΪһڵ㣬·ĻͬԤԼ
+MazeSearchStatus MazeSearchStep(MazeSearch* search, int maxNodes, double maxSeconds);
+// Ԥе
+inline MazeSearchStatus MazeSearchRun(MazeSearch* search) { return MazeSearchStep(search, 0, 0.0); }
+// ֹͣ״̬ΪSEARCH_IDLEݱ
+void MazeSearchStop(MazeSearch* search);
+// ǰǰأBFSСDFSջ򿪷беĸ±ֱָ꣬ڲ飬´ƽǰЧظ
+int MazeSearchFrontier(const MazeSearch* search, const int** cells);
+// Ƿѱʣѷֻȷ
+inline bool MazeSearchVisited(const MazeSearch* search, int i) { return PathDataSeen(search->pd, i); }
+
+#endif // MAZE_SEARCH_H
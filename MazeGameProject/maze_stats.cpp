@@ -0,0 +1,93 @@
+#include "maze_stats.h"
+#include "maze_utils.h"
+#include <string.h>
+#include <time.h>
+
+void SearchStatsRecordFill(SearchStatsRecord* record, const char* mazeName, const Maze* maze, MazeAlgorithm algo,
+    bool found, int pathLength, const PathData* pd) {
+    record->maze = mazeName;
+    record->rows = maze->rows;
+    record->cols = maze->cols;
+    record->algo = algo;
+    record->found = found;
+    record->pathLength = pathLength;
+    record->expanded = pd->expanded;
+    record->stats = pd->stats;
+}
+
+// ļǷָչβִСд
+static bool HasExtension(const char* filename, const char* ext) {
+    size_t n = strlen(filename);
+    size_t m = strlen(ext);
+    if (n < m) return false;
+    for (size_t i = 0; i < m; i++) {
+        char c = filename[n - m + i];
+        if (c >= 'A' && c <= 'Z') c = (char)(c - 'A' + 'a');
+        if (c != ext[i]) return false;
+    }
+    return true;
+}
+
+// дJSONַת뷴бܣ
+static void WriteJsonString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', file);
+        fputc(*p, file);
+    }
+    fputc('"', file);
+}
+
+// дCSVַţڲżӱ
+static void WriteCsvString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == '"') fputc('"', file);
+        fputc(*p, file);
+    }
+    fputc('"', file);
+}
+
+// дSTATS_NOT_APPLICABLEдΪnaJSONΪnullCSVΪn/a
+static void WriteCount(FILE* file, long long value, const char* na) {
+    if (value == STATS_NOT_APPLICABLE) fputs(na, file);
+    else fprintf(file, "%lld", value);
+}
+
+bool SearchStatsAppend(const char* filename, const SearchStatsRecord* record) {
+    FILE* file = MazeFileOpen(filename, "a");
+    if (file == NULL) {
+        TraceLog(LOG_ERROR, "޷дͳ־: %s", filename);
+        return false;
+    }
+    const SearchStats* s = &record->stats;
+    const char* maze = record->maze != NULL ? record->maze : "";
+    long long timestamp = (long long)time(NULL);
+
+    if (HasExtension(filename, ".json") || HasExtension(filename, ".jsonl")) {
+        fprintf(file, "{\"timestamp\": %lld, \"maze\": ", timestamp);
+        WriteJsonString(file, maze);
+        fprintf(file, ", \"rows\": %d, \"cols\": %d, \"algorithm\": ", record->rows, record->cols);
+        WriteJsonString(file, MazeAlgorithmName(record->algo));
+        fprintf(file, ", \"found\": %s, \"path_length\": %d, \"expanded\": %d, \"pushes\": %lld, \"pops\": %lld, \"relaxations\": ",
+            record->found ? "true" : "false", record->pathLength, record->expanded, s->pushes, s->pops);
+        WriteCount(file, s->relaxations, "null");
+        fprintf(file, ", \"peak_frontier\": %d, \"bytes_allocated\": %llu, \"ms\": %.4f}\n",
+            s->peakFrontier, (unsigned long long)s->bytesAllocated, s->milliseconds);
+    }
+    else {
+        // ׷ģʽļλĩβλΪ0˵ļ
+        fseek(file, 0, SEEK_END);
+        if (ftell(file) == 0) {
+            fprintf(file, "timestamp,maze,rows,cols,algorithm,found,path_length,expanded,pushes,pops,relaxations,peak_frontier,bytes_allocated,ms\n");
+        }
+        fprintf(file, "%lld,", timestamp);
+        WriteCsvString(file, maze);
+        fprintf(file, ",%d,%d,", record->rows, record->cols);
+        WriteCsvString(file, MazeAlgorithmName(record->algo));
+        fprintf(file, ",%d,%d,%d,%lld,%lld,", record->found ? 1 : 0, record->pathLength, record->expanded, s->pushes, s->pops);
+        WriteCount(file, s->relaxations, "n/a");
+        fprintf(file, ",%d,%llu,%.4f\n", s->peakFrontier, (unsigned long long)s->bytesAllocated, s->milliseconds);
+    }
+    return fclose(file) == 0;
+}
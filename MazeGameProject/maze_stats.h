@@ -0,0 +1,29 @@
+#pragma once
+#ifndef MAZE_STATS_H
+#define MAZE_STATS_H
+
+#include "maze_config.h"
+#include "maze_algorithms.h"
+
+// ͳ־ÿ׷һ¼ͬһԹϱȽϸ㷨ռȵݡ
+// ʽļչѡ.json/.jsonlΪÿһJSONJSON LinesΪCSVļΪʱдͷ
+
+// һͳƼ¼
+typedef struct {
+    const char* maze;     // Թƣļɲ
+    int rows;             // Թ
+    int cols;             // Թ
+    MazeAlgorithm algo;   // 㷨
+    bool found;           // Ƿҵ·
+    int pathLength;       // ·
+    int expanded;         // չĽڵ
+    SearchStats stats;    // ͳ
+} SearchStatsRecord;
+
+// ùһͳд¼
+void SearchStatsRecordFill(SearchStatsRecord* record, const char* mazeName, const Maze* maze, MazeAlgorithm algo,
+    bool found, int pathLength, const PathData* pd);
+// Ѽ¼׷ӵ־ļʧܷfalse
+bool SearchStatsAppend(const char* filename, const SearchStatsRecord* record);
+
+#endif // MAZE_STATS_H
@@ -7,52 +7,74 @@ MazeTextures* TexturesLoad() {
         return NULL;
     }
 
-    // ȷͼƬļͬĿ¼
-    tex->start = LoadTexture("start.png");
-    tex->end = LoadTexture("end.png");
-    tex->floor = LoadTexture("floor.png");
-    tex->wall = LoadTexture("wall.png");
-    tex->grass = LoadTexture("grass.png");
-    tex->lava = LoadTexture("lava.png");
-    tex->character = LoadTexture("character.png");
-    tex->slime = LoadTexture("slime.png");
-
-    // Уؽ
-    Texture2D* texList[] = {&tex->start, &tex->end, &tex->floor, &tex->wall, 
-                           &tex->grass, &tex->lava, &tex->character, &tex->slime};
-    const char* names[] = {"start", "end", "floor", "wall", "grass", "lava", "character", "slime"};
+    // ͼƬȷͼƬļͬĿ¼˳TileSpriteһ
+    const char* names[TILE_COUNT] = { "end", "start", "floor", "wall", "grass", "lava", "character", "slime" };
+    Image images[TILE_COUNT];
     bool loadFailed = false;
-    for (int i = 0; i < 8; i++) {
-        if (texList[i]->id == 0) {
+    for (int i = 0; i < TILE_COUNT; i++) {
+        images[i] = LoadImage(TextFormat("%s.png", names[i]));
+        if (images[i].data == NULL) {
             TraceLog(LOG_ERROR, "ʧ: %s.png", names[i]);
             loadFailed = true;
         }
     }
 
-    // ʧͷѼص
-    if (loadFailed) {
-        for (int i = 0; i < 8; i++) {
-            if (texList[i]->id != 0) {
-                UnloadTexture(*texList[i]);
-            }
+    // ŷͼ飬¼ÿͼԴ򲢵õͼߴ
+    int atlasWidth = 0;
+    int atlasHeight = 0;
+    int penX = 0, penY = 0, rowHeight = 0;
+    for (int i = 0; i < TILE_COUNT && !loadFailed; i++) {
+        if (penX > 0 && penX + images[i].width > ATLAS_MAX_WIDTH) {
+            penX = 0;
+            penY += rowHeight + ATLAS_PADDING;
+            rowHeight = 0;
+        }
+        tex->rects[i] = Rectangle{ (float)penX, (float)penY, (float)images[i].width, (float)images[i].height };
+        penX += images[i].width + ATLAS_PADDING;
+        if (images[i].height > rowHeight) rowHeight = images[i].height;
+        if (penX - ATLAS_PADDING > atlasWidth) atlasWidth = penX - ATLAS_PADDING;
+        if (penY + rowHeight > atlasHeight) atlasHeight = penY + rowHeight;
+    }
+
+    // ͼƬͼϴΪһ
+    tex->atlas.id = 0;
+    if (!loadFailed) {
+        Image atlas = GenImageColor(atlasWidth, atlasHeight, BLANK);
+        for (int i = 0; i < TILE_COUNT; i++) {
+            Rectangle src = { 0.0f, 0.0f, (float)images[i].width, (float)images[i].height };
+            ImageDraw(&atlas, images[i], src, tex->rects[i], WHITE);
+        }
+        tex->atlas = LoadTextureFromImage(atlas);
+        UnloadImage(atlas);
+        if (tex->atlas.id == 0) {
+            TraceLog(LOG_ERROR, "ͼʧܣ%dx%d", atlasWidth, atlasHeight);
+            loadFailed = true;
         }
+    }
+    for (int i = 0; i < TILE_COUNT; i++) {
+        if (images[i].data != NULL) UnloadImage(images[i]);
+    }
+
+    if (loadFailed) {
         free(tex);
         return NULL;
     }
 
-    TraceLog(LOG_INFO, "سɹ");
+    // Ԥøͼ
+    for (int i = 0; i < TILE_COUNT; i++) {
+        const Rectangle* r = &tex->rects[i];
+        tex->uv[i].u0 = r->x / tex->atlas.width;
+        tex->uv[i].v0 = r->y / tex->atlas.height;
+        tex->uv[i].u1 = (r->x + r->width) / tex->atlas.width;
+        tex->uv[i].v1 = (r->y + r->height) / tex->atlas.height;
+    }
+
+    TraceLog(LOG_INFO, "سɹͼ%dx%d", tex->atlas.width, tex->atlas.height);
     return tex;
 }
 
 void TexturesUnload(MazeTextures* tex) {
     if (tex == NULL) return;
-    UnloadTexture(tex->start);
-    UnloadTexture(tex->end);
-    UnloadTexture(tex->floor);
-    UnloadTexture(tex->wall);
-    UnloadTexture(tex->grass);
-    UnloadTexture(tex->lava);
-    UnloadTexture(tex->character);
-    UnloadTexture(tex->slime);
+    UnloadTexture(tex->atlas);
     free(tex);
 }
\ No newline at end of file
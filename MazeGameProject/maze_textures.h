@@ -4,19 +4,40 @@
 
 #include "maze_config.h"
 
-// Դṹ
+// ͼţǰCellType+2Уγɱ±һ£
+typedef enum {
+    TILE_END = 0,    // յ
+    TILE_START,      // 
+    TILE_FLOOR,      // ͨ
+    TILE_WALL,       // ǽ
+    TILE_GRASS,      // ݵ
+    TILE_LAVA,       // 
+    TILE_CHARACTER,  // ɫ
+    TILE_SLIME,      // 
+    TILE_COUNT
+} TileSprite;
+
+// ͼ
+constexpr int ATLAS_MAX_WIDTH = 512;  // ͼޣдŷţŲʱУ
+constexpr int ATLAS_PADDING = 2;      // ͼ֮͸ʱɫ
+
+// ͼĹһ
 typedef struct {
-    Texture2D start;    // 
-    Texture2D end;      // յ
-    Texture2D floor;    // ͨ
-    Texture2D wall;     // ǽ
-    Texture2D grass;    // ݵ
-    Texture2D lava;     // 
-    Texture2D character;// ɫ
-    Texture2D slime;    // 
+    float u0, v0;  // Ͻ
+    float u1, v1;  // ½
+} TileUV;
+
+// Դṹ壺ͼƬڼʱһͼʱͼŲȡԴ
+typedef struct {
+    Texture2D atlas;              // ͼ
+    Rectangle rects[TILE_COUNT];  // ͼͼеԴأ
+    TileUV uv[TILE_COUNT];        // ͼ꣨ã
 } MazeTextures;
 
-// 
+// ؿͶӦͼ
+inline TileSprite TileForCell(CellType type) { return (TileSprite)(type - CELL_END); }
+
+// Ϊͼ
 MazeTextures* TexturesLoad();
 // ͷԴ
 void TexturesUnload(MazeTextures* tex);
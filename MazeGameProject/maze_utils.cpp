@@ -1,9 +1,42 @@
 #include "maze_utils.h"
+#include <string.h>
+
+#ifdef MAZE_HEADLESS
+#include <stdarg.h>
+
+static int g_logLevel = LOG_INFO;
+
+void SetTraceLogLevel(int logLevel) {
+    g_logLevel = logLevel;
+}
+
+void TraceLog(int logLevel, const char* text, ...) {
+    if (logLevel < g_logLevel) return;
+    static const char* prefix[LOG_NONE + 1] = { "", "TRACE: ", "DEBUG: ", "INFO: ", "WARNING: ", "ERROR: ", "FATAL: ", "" };
+    FILE* out = (logLevel >= LOG_WARNING) ? stderr : stdout;
+    va_list args;
+    va_start(args, text);
+    fputs(prefix[(logLevel >= LOG_ALL && logLevel <= LOG_NONE) ? logLevel : LOG_NONE], out);
+    vfprintf(out, text, args);
+    fputc('\n', out);
+    va_end(args);
+}
+#endif
 
 bool IsPointValid(Maze* maze, int x, int y) {
     return (x >= 0 && x < maze->cols && y >= 0 && y < maze->rows);
 }
 
+FILE* MazeFileOpen(const char* filename, const char* mode) {
+#ifdef _MSC_VER
+    FILE* file = NULL;
+    if (fopen_s(&file, filename, mode) != 0) return NULL;
+    return file;
+#else
+    return fopen(filename, mode);
+#endif
+}
+
 PathData* PathDataCreate(Maze* maze) {
     PathData* pd = (PathData*)malloc(sizeof(PathData));
     if (pd == NULL) {
@@ -11,151 +44,273 @@ PathData* PathDataCreate(Maze* maze) {
         return NULL;
     }
 
-    // ʼʱ
-    pd->visited = (bool**)malloc(maze->rows * sizeof(bool*));
-    if (pd->visited == NULL) {
-        TraceLog(LOG_ERROR, "ڴʧܣʱ");
-        free(pd);
-        return NULL;
-    }
-    for (int y = 0; y < maze->rows; y++) {
-        pd->visited[y] = (bool*)calloc(maze->cols, sizeof(bool));
-        if (pd->visited[y] == NULL) {
-            TraceLog(LOG_ERROR, "ڴʧܣʱ");
-            // ͷѷڴ
-            for (int j = 0; j < y; j++) {
-                free(pd->visited[j]);
-            }
-            free(pd->visited);
-            free(pd);
-            return NULL;
-        }
-    }
-
-    // ʼڵ
-    pd->parent = (Point**)malloc(maze->rows * sizeof(Point*));
-    if (pd->parent == NULL) {
-        TraceLog(LOG_ERROR, "ڴʧܣڵ");
-        // ͷѷڴ
-        for (int j = 0; j < maze->rows; j++) {
-            free(pd->visited[j]);
-        }
-        free(pd->visited);
-        free(pd);
-        return NULL;
-    }
-    for (int y = 0; y < maze->rows; y++) {
-        pd->parent[y] = (Point*)malloc(maze->cols * sizeof(Point));
-        if (pd->parent[y] == NULL) {
-            TraceLog(LOG_ERROR, "ڴʧܣڵ");
-            // ͷѷڴ
-            for (int j = 0; j < maze->rows; j++) {
-                free(pd->visited[j]);
-            }
-            free(pd->visited);
-            for (int j = 0; j < y; j++) {
-                free(pd->parent[j]);
-            }
-            free(pd->parent);
-            free(pd);
-            return NULL;
-        }
-        for (int x = 0; x < maze->cols; x++) {
-            pd->parent[y][x].x = -1; // ڵʼΪЧ
-            pd->parent[y][x].y = -1;
-        }
-    }
-
-    // ʼ루Dijkstraã
-    pd->distance = (int**)malloc(maze->rows * sizeof(int*));
-    if (pd->distance == NULL) {
-        TraceLog(LOG_ERROR, "ڴʧܣ");
-        // ͷѷڴ
-        for (int j = 0; j < maze->rows; j++) {
-            free(pd->visited[j]);
-            free(pd->parent[j]);
-        }
-        free(pd->visited);
-        free(pd->parent);
-        free(pd);
+    // ƽ飬ÿһη䣻stampȫ0δʡcallocҳύ
+    size_t total = (size_t)maze->rows * maze->cols;
+    pd->cellCount = (int)total;
+    pd->generation = 2;
+    pd->stamp = (unsigned int*)calloc(total, sizeof(unsigned int));
+    pd->parent = (int*)malloc(total * sizeof(int));
+    pd->distance = (int*)malloc(total * sizeof(int));
+    pd->queue = NULL;
+    pd->dirStack = NULL;
+    pd->heap = NULL;
+    pd->buckets = NULL;
+    pd->bitGrid = NULL;
+    pd->bitWork = NULL;
+    pd->hpa = NULL;
+    pd->hpaSearch = NULL;
+    pd->dstar = NULL;
+    pd->backStamp = NULL;
+    pd->backParent = NULL;
+    pd->backDistance = NULL;
+    pd->backQueue = NULL;
+    pd->backHeap = NULL;
+    pd->padGrid = NULL;
+    pd->padBytes = 0;
+    pd->components = NULL;
+    pd->preprocessShared = false;
+    pd->expanded = 0;
+    pd->threads = 0;
+    pd->cancel = NULL;
+    memset(&pd->stats, 0, sizeof(SearchStats));
+    if (pd->stamp == NULL || pd->parent == NULL || pd->distance == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ·飨%dӣ", pd->cellCount);
+        PathDataDestroy(maze, pd);
         return NULL;
     }
-    for (int y = 0; y < maze->rows; y++) {
-        pd->distance[y] = (int*)malloc(maze->cols * sizeof(int));
-        if (pd->distance[y] == NULL) {
-            TraceLog(LOG_ERROR, "ڴʧܣ");
-            // ͷѷڴ
-            for (int j = 0; j < maze->rows; j++) {
-                free(pd->visited[j]);
-                free(pd->parent[j]);
-            }
-            free(pd->visited);
-            free(pd->parent);
-            for (int j = 0; j < y; j++) {
-                free(pd->distance[j]);
-            }
-            free(pd->distance);
-            free(pd);
-            return NULL;
-        }
-        for (int x = 0; x < maze->cols; x++) {
-            pd->distance[y][x] = INT_MAX; // ʼΪ
-        }
-    }
 
     return pd;
 }
 
 void PathDataDestroy(Maze* maze, PathData* pd) {
+    (void)maze;
     if (pd == NULL) return;
-    // ͷŷʱ
-    for (int y = 0; y < maze->rows; y++) {
-        free(pd->visited[y]);
-    }
-    free(pd->visited);
-    // ͷŸڵ
-    for (int y = 0; y < maze->rows; y++) {
-        free(pd->parent[y]);
-    }
+    free(pd->stamp);
     free(pd->parent);
-    // ͷž
-    for (int y = 0; y < maze->rows; y++) {
-        free(pd->distance[y]);
-    }
     free(pd->distance);
+    free(pd->queue);
+    free(pd->dirStack);
+    IndexedHeapDestroy(pd->heap);
+    BucketQueueDestroy(pd->buckets);
+    BitBfsWorkDestroy(pd->bitWork);
+    HpaSearchDestroy(pd->hpaSearch);
+    DStarDestroy(pd->dstar);
+    free(pd->backStamp);
+    free(pd->backParent);
+    free(pd->backDistance);
+    free(pd->backQueue);
+    IndexedHeapDestroy(pd->backHeap);
+    if (!pd->preprocessShared) {
+        BitGridDestroy(pd->bitGrid);
+        HpaDestroy(pd->hpa);
+        free(pd->padGrid);
+        ComponentIndexDestroy(pd->components);
+    }
     free(pd);
 }
 
-int PathBacktrack(Maze* maze, PathData* pd, Point* path, int maxPathLen) {
-    Point current = maze->end;
-    int pathLen = 0;
+size_t PathDataMemoryBytes(const PathData* pd) {
+    size_t cells = (size_t)pd->cellCount;
+    size_t bytes = sizeof(PathData) + cells * (sizeof(unsigned int) + 2 * sizeof(int));
+    if (pd->queue != NULL) bytes += cells * sizeof(int);
+    if (pd->dirStack != NULL) bytes += cells;
+    if (pd->heap != NULL) bytes += sizeof(IndexedHeap) + cells * (2 * sizeof(int) + sizeof(long long));
+    if (pd->buckets != NULL) {
+        bytes += sizeof(BucketQueue) + cells * 3 * sizeof(int) + (size_t)pd->buckets->bucketCount * sizeof(int);
+    }
+    if (pd->bitWork != NULL) {
+        const BitBfsWork* w = pd->bitWork;
+        bytes += sizeof(BitBfsWork) + (size_t)w->wordCount * 3 * sizeof(unsigned long long);
+        bytes += (size_t)w->levelCapacity * sizeof(int) + (size_t)w->entryCapacity * (sizeof(int) + sizeof(unsigned long long));
+    }
+    bytes += HpaSearchMemoryBytes(pd->hpaSearch);
+    if (pd->dstar != NULL) bytes += sizeof(DStarLite) + (size_t)pd->cellCount * (4 * sizeof(int) + sizeof(long long));
+    if (pd->backStamp != NULL) bytes += cells * (sizeof(unsigned int) + 2 * sizeof(int));
+    if (pd->backQueue != NULL) bytes += cells * sizeof(int);
+    if (pd->backHeap != NULL) bytes += sizeof(IndexedHeap) + cells * (2 * sizeof(int) + sizeof(long long));
+    if (!pd->preprocessShared) {
+        if (pd->bitGrid != NULL) bytes += sizeof(BitGrid) + (size_t)pd->bitGrid->wordCount * sizeof(unsigned long long);
+        bytes += HpaMemoryBytes(pd->hpa);
+        if (pd->padGrid != NULL) bytes += pd->padBytes;
+        bytes += ComponentIndexMemoryBytes(pd->components);
+    }
+    return bytes;
+}
 
-    // ֱ
-    while (current.x != -1 && current.y != -1 && pathLen < maxPathLen) {
-        path[pathLen++] = current;
-        current = pd->parent[current.y][current.x];
+void PathDataReset(PathData* pd) {
+    pd->expanded = 0;
+#if MAZE_STATS
+    memset(&pd->stats, 0, sizeof(SearchStats));
+#endif
+    pd->generation += 2;
+    // żʱһ
+    if (pd->generation > UINT_MAX - 2) {
+        memset(pd->stamp, 0, (size_t)pd->cellCount * sizeof(unsigned int));
+        if (pd->backStamp != NULL) memset(pd->backStamp, 0, (size_t)pd->cellCount * sizeof(unsigned int));
+        pd->generation = 2;
+    }
+}
 
-        // ֹѭ·δͨ
-        if (pathLen >= maxPathLen) {
-            TraceLog(LOG_WARNING, "·ݳȳֵ%d", maxPathLen);
-            break;
-        }
+bool PathDataReserveQueue(PathData* pd) {
+    if (pd->queue == NULL) {
+        pd->queue = (int*)malloc((size_t)pd->cellCount * sizeof(int));
+    }
+    if (pd->dirStack == NULL) {
+        pd->dirStack = (unsigned char*)malloc((size_t)pd->cellCount);
+    }
+    if (pd->queue == NULL || pd->dirStack == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ");
+        return false;
     }
+    return true;
+}
 
-    // Ƿݵ
-    if (pathLen > 0 && (path[pathLen - 1].x != maze->start.x || path[pathLen - 1].y != maze->start.y)) {
-        TraceLog(LOG_WARNING, "·δݵ㣬·ͨ");
-        pathLen = 0;
-        return pathLen;
+IndexedHeap* PathDataHeap(PathData* pd) {
+    if (pd->heap == NULL) {
+        pd->heap = IndexedHeapCreate(pd->cellCount);
+    }
+    else {
+        IndexedHeapClear(pd->heap);
     }
+    return pd->heap;
+}
 
-    // ת·תΪ㵽յ㣩
-    for (int i = 0; i < pathLen / 2; i++) {
-        Point temp = path[i];
-        path[i] = path[pathLen - 1 - i];
-        path[pathLen - 1 - i] = temp;
+BucketQueue* PathDataBuckets(PathData* pd, int maxCost) {
+    if (pd->buckets != NULL && pd->buckets->bucketCount < maxCost + 1) {
+        BucketQueueDestroy(pd->buckets);
+        pd->buckets = NULL;
+    }
+    if (pd->buckets == NULL) {
+        pd->buckets = BucketQueueCreate(pd->cellCount, maxCost);
     }
+    else {
+        BucketQueueClear(pd->buckets);
+    }
+    return pd->buckets;
+}
+
+// õԤṹȱʧʱ޷Ľṹͷţ
+static bool PathDataSharedMissing(const PathData* pd, const char* what) {
+    if (!pd->preprocessShared) return false;
+    TraceLog(LOG_ERROR, "õĹδ%s", what);
+    return true;
+}
+
+bool PathDataReserveBits(PathData* pd, Maze* maze) {
+    if (pd->bitGrid == NULL) {
+        if (PathDataSharedMissing(pd, "ͨλͼ")) return false;
+        pd->bitGrid = BitGridCreate(maze);
+        if (pd->bitGrid == NULL) return false;
+    }
+    if (pd->bitWork == NULL) {
+        pd->bitWork = BitBfsWorkCreate(pd->bitGrid);
+        if (pd->bitWork == NULL) return false;
+    }
+    return true;
+}
+
+bool PathDataReserveHpa(PathData* pd, Maze* maze) {
+    if (pd->hpa == NULL) {
+        if (PathDataSharedMissing(pd, "ֲͼ")) return false;
+        pd->hpa = HpaCreate(maze, DEFAULT_TERRAIN_COST, HPA_CLUSTER_SIZE, pd->threads);
+        if (pd->hpa == NULL) return false;
+    }
+    if (pd->hpaSearch == NULL) {
+        pd->hpaSearch = HpaSearchCreate(pd->hpa->clusterSize);
+        if (pd->hpaSearch == NULL) return false;
+    }
+    return true;
+}
+
+bool PathDataReserveDStar(PathData* pd, Maze* maze) {
+    if (pd->dstar == NULL) {
+        pd->dstar = DStarCreate(maze, DEFAULT_TERRAIN_COST);
+        if (pd->dstar == NULL) return false;
+    }
+    return true;
+}
+
+bool PathDataReservePadded(PathData* pd, Maze* maze) {
+    if (pd->padGrid != NULL) return true;
+    if (PathDataSharedMissing(pd, "ǽ")) return false;
+    size_t stride = (size_t)maze->cols + 2;
+    size_t bytes = stride * ((size_t)maze->rows + 2);
+    pd->padGrid = (signed char*)malloc(bytes);
+    if (pd->padGrid == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣǽ%d %dУ", maze->rows, maze->cols);
+        return false;
+    }
+    // βÿΪǽми
+    memset(pd->padGrid, CELL_WALL, bytes);
+    for (int y = 0; y < maze->rows; y++) {
+        memcpy(pd->padGrid + (y + 1) * stride + 1, maze->grid + (size_t)y * maze->cols, (size_t)maze->cols);
+    }
+    pd->padBytes = bytes;
+    return true;
+}
+
+const ComponentIndex* PathDataReserveComponents(PathData* pd, Maze* maze) {
+    if (pd->components == NULL) {
+        if (PathDataSharedMissing(pd, "ͨ")) return NULL;
+        pd->components = ComponentIndexCreate(maze, pd->threads);
+        return pd->components;
+    }
+    if (pd->preprocessShared) return pd->components->dirty ? NULL : pd->components;
+    return ComponentIndexRefresh(pd->components, maze) ? pd->components : NULL;
+}
+
+void PathDataShare(PathData* pd, const PathData* owner) {
+    pd->padGrid = owner->padGrid;
+    pd->padBytes = owner->padBytes;
+    pd->bitGrid = owner->bitGrid;
+    pd->hpa = owner->hpa;
+    pd->components = owner->components;
+    pd->preprocessShared = true;
+}
+
+bool PathDataReserveBackward(PathData* pd, bool needQueue, bool needHeap) {
+    if (pd->backStamp == NULL) {
+        // stampͬȫ0δʡ֮generationһʧЧ
+        pd->backStamp = (unsigned int*)calloc((size_t)pd->cellCount, sizeof(unsigned int));
+        pd->backParent = (int*)malloc((size_t)pd->cellCount * sizeof(int));
+        pd->backDistance = (int*)malloc((size_t)pd->cellCount * sizeof(int));
+    }
+    if (needQueue && pd->backQueue == NULL) {
+        pd->backQueue = (int*)malloc((size_t)pd->cellCount * sizeof(int));
+    }
+    if (needHeap) {
+        if (pd->backHeap == NULL) pd->backHeap = IndexedHeapCreate(pd->cellCount);
+        else IndexedHeapClear(pd->backHeap);
+    }
+    if (pd->backStamp == NULL || pd->backParent == NULL || pd->backDistance == NULL ||
+        (needQueue && pd->backQueue == NULL) || (needHeap && pd->backHeap == NULL)) {
+        TraceLog(LOG_ERROR, "ڴʧܣ˫%dӣ", pd->cellCount);
+        return false;
+    }
+    return true;
+}
+
+void PathDataJoin(PathData* pd, Maze* maze, int meet, const int* costTable) {
+    // طһĺߵյ㣬дΪ򸸽ڵ밴ɱۼ
+    int prev = meet;
+    int dist = pd->distance[meet];
+    for (int cur = pd->backParent[meet]; cur != -1; cur = pd->backParent[cur]) {
+        dist += costTable != NULL ? TerrainCost(costTable, (CellType)maze->grid[cur]) : 1;
+        PathDataSet(pd, cur, dist, prev);
+        prev = cur;
+    }
+}
 
-    TraceLog(LOG_INFO, "·ɣ·ȣ%d", pathLen);
-    return pathLen;
+bool PathDataSetCell(PathData* pd, Maze* maze, int x, int y, CellType type) {
+    if (!IsPointValid(maze, x, y)) return false;
+    CellType previous = MazeGetCell(maze, x, y);
+    maze->grid[MazeIndex(maze, x, y)] = (signed char)type;
+    if (pd->dstar != NULL) DStarSetCell(pd->dstar, maze, x, y, type);
+    // õԤṹɳзͬ
+    if (pd->preprocessShared) return true;
+    if (pd->components != NULL) ComponentIndexSetCell(pd->components, maze, x, y, previous);
+    if (pd->padGrid != NULL) pd->padGrid[(size_t)(y + 1) * (maze->cols + 2) + x + 1] = (signed char)type;
+    if (pd->bitGrid != NULL) BitGridSetCell(pd->bitGrid, MazeIndex(maze, x, y), type != CELL_WALL);
+    if (pd->hpa != NULL) return HpaSetCell(pd->hpa, maze, x, y, type);
+    return true;
 }
\ No newline at end of file
@@ -3,14 +3,148 @@
 #define MAZE_UTILS_H
 
 #include "maze_config.h"
+#include "maze_queue.h"
+#include "maze_bitbfs.h"
+#include "maze_hpa.h"
+#include "maze_dstar.h"
+#include "maze_components.h"
+#include "maze_path.h"
 
 // УǷЧ
 bool IsPointValid(Maze* maze, int x, int y);
-// ʼ·
+// ת±꣨ȣ
+inline int MazeIndex(const Maze* maze, int x, int y) { return y * maze->cols + x; }
+// ȡؿ
+inline CellType MazeGetCell(const Maze* maze, int x, int y) { return (CellType)maze->grid[MazeIndex(maze, x, y)]; }
+// ±ת
+inline Point MazePointFromIndex(const Maze* maze, int index) { Point p = { index % maze->cols, index / maze->cols }; return p; }
+// ѯؿƶɱCOST_IMPASSABLEʾͨУ
+inline int TerrainCost(const int* costTable, CellType type) { return costTable[type - CELL_END]; }
+// αsplitmix64ͬڸƽ̨һ£
+inline unsigned long long MazeRandom(unsigned long long* state) {
+    unsigned long long z = (*state += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+// [0, n)֮
+inline int MazeRandomBelow(unsigned long long* state, int n) { return (int)(((MazeRandom(state) >> 32) * (unsigned long long)n) >> 32); }
+// [0, 1)֮С
+inline double MazeRandomUnit(unsigned long long* state) { return (double)(MazeRandom(state) >> 11) * (1.0 / 9007199254740992.0); }
+// ƽ̨ļMSVCʹfopen_sʧܷNULL
+FILE* MazeFileOpen(const char* filename, const char* mode);
+// ʼ·ݣԹߴһΣ
 PathData* PathDataCreate(Maze* maze);
 // ͷ·
 void PathDataDestroy(Maze* maze, PathData* pd);
-// ··ȣ
-int PathBacktrack(Maze* maze, PathData* pd, Point* path, int maxPathLen);
+// ͳƹǰռõĶڴ棨ֽڣĶУ
+size_t PathDataMemoryBytes(const PathData* pd);
+// ʼһֻţO(1)ʹϴȫʧЧ
+void PathDataReset(PathData* pd);
+// ȷBFS/DFSջѷ
+bool PathDataReserveQueue(PathData* pd);
+// ȡպѣ״ʹʱ䣩
+IndexedHeap* PathDataHeap(PathData* pd);
+// ȡպͰУͰʱ·䣩
+BucketQueue* PathDataBuckets(PathData* pd, int maxCost);
+// ȷλBFSλͼ빤Ѿ״ʹʱԹλͼʱֻ乤
+bool PathDataReserveBits(PathData* pd, Maze* maze);
+// ȷHPA*ֲͼѯѾ״ʹʱԹĬϳɱԤ߳ȡpd->threadsֲͼʱֻѯ
+bool PathDataReserveHpa(PathData* pd, Maze* maze);
+// ȷD* Lite滮ѷ
+bool PathDataReserveDStar(PathData* pd, Maze* maze);
+// ȷǽ񸱱ѽ״ʹʱԹƣԹ޸ĺͨPathDataSetCellͬ
+bool PathDataReservePadded(PathData* pd, Maze* maze);
+// ȷͨѽΪ£״ʹʱpd->threadsбǣⲿʱ޸ģдؽ޸ʱNULL
+const ComponentIndex* PathDataReserveComponents(PathData* pd, Maze* maze);
+// ownerѽֻԤṹǽλͼֲͼͨpdΪմδЩṹĹ
+// úpdٲȱʧĽṹҲؿ޸ͬǣownerpd֮ͷ
+void PathDataShare(PathData* pd, const PathData* owner);
+// ȷ˫ķѷ䣨needQueue/needHeap踽BFSлպķѣ
+bool PathDataReserveBackward(PathData* pd, bool needQueue, bool needHeap);
+// ޸ĵؿ鲢ͬа轨Ľṹǽλͼֲͼ滮ͨؽ
+bool PathDataSetCell(PathData* pd, Maze* maze, int x, int y, CellType type);
+
+// Ƿѷָø
+inline bool PathDataSeen(const PathData* pd, int i) { return pd->stamp[i] - pd->generation <= 1u; }
+// Ƿȷø
+inline bool PathDataClosed(const PathData* pd, int i) { return pd->stamp[i] == pd->generation + 1; }
+// ȡ루δʱΪINT_MAX
+inline int PathDataDistance(const PathData* pd, int i) { return PathDataSeen(pd, i) ? pd->distance[i] : INT_MAX; }
+// ȡڵ±꣨δʱΪ-1
+inline int PathDataParent(const PathData* pd, int i) { return PathDataSeen(pd, i) ? pd->parent[i] : -1; }
+// ¼ѷָӵľ븸ڵ
+inline void PathDataSet(PathData* pd, int i, int dist, int parent) {
+    pd->stamp[i] = pd->generation;
+    pd->distance[i] = dist;
+    pd->parent[i] = parent;
+}
+// ǸΪȷ
+inline void PathDataClose(PathData* pd, int i) { pd->stamp[i] = pd->generation + 1; }
+// ڱеıǣָΪδʣ
+inline void PathDataForget(PathData* pd, int i) { pd->stamp[i] = 0; }
+// һǷѷָø
+inline bool PathDataBackSeen(const PathData* pd, int i) { return pd->backStamp[i] - pd->generation <= 1u; }
+// һǷȷø
+inline bool PathDataBackClosed(const PathData* pd, int i) { return pd->backStamp[i] == pd->generation + 1; }
+// ȡһൽյľ루δʱΪINT_MAX
+inline int PathDataBackDistance(const PathData* pd, int i) { return PathDataBackSeen(pd, i) ? pd->backDistance[i] : INT_MAX; }
+// ¼һѷָӵľ
+inline void PathDataBackSet(PathData* pd, int i, int dist, int next) {
+    pd->backStamp[i] = pd->generation;
+    pd->backDistance[i] = dist;
+    pd->backParent[i] = next;
+}
+// ǸڷһΪȷ
+inline void PathDataBackClose(PathData* pd, int i) { pd->backStamp[i] = pd->generation + 1; }
+// ͳƣһΣfrontierΪӺǰشСʹPathDataģ顪ֲͼ滮λBFSֱӼԼͳƣ
+inline void SearchStatsPush(SearchStats* stats, int frontier) {
+#if MAZE_STATS
+    stats->pushes++;
+    if (frontier > stats->peakFrontier) stats->peakFrontier = frontier;
+#else
+    (void)stats;
+    (void)frontier;
+#endif
+}
+// ͳƣһ
+inline void SearchStatsPop(SearchStats* stats) {
+#if MAZE_STATS
+    stats->pops++;
+#else
+    (void)stats;
+#endif
+}
+// ͳƣһڱ
+inline void SearchStatsRelax(SearchStats* stats) {
+#if MAZE_STATS
+    stats->relaxations++;
+#else
+    (void)stats;
+#endif
+}
+// ͳƣһΣfrontierΪӺǰشС
+inline void PathDataStatPush(PathData* pd, int frontier) { SearchStatsPush(&pd->stats, frontier); }
+// ͳƣһ
+inline void PathDataStatPop(PathData* pd) { SearchStatsPop(&pd->stats); }
+// ͳƣһڱ
+inline void PathDataStatRelax(PathData* pd) { SearchStatsRelax(&pd->stats); }
+// ͳƣģԼͳƵļӡӡɳڡǰطֵ빤
+inline void PathDataStatCopy(PathData* pd, const SearchStats* stats) {
+#if MAZE_STATS
+    pd->stats.pushes = stats->pushes;
+    pd->stats.pops = stats->pops;
+    pd->stats.relaxations = stats->relaxations;
+    pd->stats.peakFrontier = stats->peakFrontier;
+#else
+    (void)pd;
+    (void)stats;
+#endif
+}
+// Ƿѱȡ㷨ÿչһڵһΣȡ󷵻falseϣ
+inline bool PathDataCancelled(const PathData* pd) { return pd->cancel != NULL && pd->cancel->load(std::memory_order_relaxed); }
+// ˫·meetƴӣһĺдΪ򸸽ڵ֮PathBacktrackɴյֱӻ
+// costTableΪNULLʱÿ1BFS
+void PathDataJoin(PathData* pd, Maze* maze, int meet, const int* costTable);
 
 #endif // MAZE_UTILS_H
\ No newline at end of file
@@ -0,0 +1,612 @@
+// Ѱ·ߣͼν棬ʱMAZE_HEADLESSraylibʾĹУ
+// ΪԹļĿ¼Ŀ¼µļ⣩ļָ̳߳ز⣬
+// ˳״̬·ɱչʱѡ·
+// ÷ʾ
+//   MazeSolver ../MazeGameProject/maze20x20.txt
+//   MazeSolver --algo A* --format csv --out results.csv levels
+//   MazeSolver --algo 5 --moves 8 --paths --format jsonl --recursive --ext .txt levels extra/level1.txt
+// LinuxڱĿ¼ִmake루ԴļбѡMakefileWindowsʹMazeSolver.vcxproj
+// ˳룺0Ϊȫɴ2ΪԹɴʧܣ1Ϊдʧ
+#include "maze_data.h"
+#include "maze_utils.h"
+#include "maze_algorithms.h"
+#include "maze_parallel.h"
+#include <string.h>
+#include <chrono>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <sys/stat.h>
+#endif
+
+// ʽ
+typedef enum {
+    OUTPUT_TEXT = 0,   // ı
+    OUTPUT_CSV,        // CSVΪͷ
+    OUTPUT_JSON,       // JSON
+    OUTPUT_JSONL,      // JSON LinesÿԹһУ
+    OUTPUT_FORMAT_COUNT
+} OutputFormat;
+
+// Թ״̬
+typedef enum {
+    SOLVE_SOLVED = 0,  // ҵ·
+    SOLVE_NO_PATH,     // յ㲻ɴ
+    SOLVE_LOAD_FAILED, // ļ޷
+    SOLVE_ERROR,       // ڴ治
+    SOLVE_STATUS_COUNT
+} SolveStatus;
+
+// в
+typedef struct {
+    char** inputs;         // ԹļĿ¼
+    int inputCount;
+    MazeAlgorithm algo;    // Ѱ·㷨
+    MazeMovement movement; // ƶʽ
+    OutputFormat format;   // ʽ
+    const char* outPath;   // ļNULLΪ׼
+    int threads;           // ߳<=0ΪȫӲ̣߳
+    bool paths;            // ·
+    bool recursive;        // ݹɨĿ¼
+    const char* extension; // ɨĿ¼ʱֻȡչļNULLΪȫļ
+} SolverOptions;
+
+// ļб
+typedef struct {
+    char** paths;
+    int count;
+    int capacity;
+} FileList;
+
+// Թ
+typedef struct {
+    SolveStatus status;
+    int rows;
+    int cols;
+    int pathLength;
+    long long pathCost;
+    int expanded;
+    double loadMs;         // غʱ룩
+    double solveMs;        // ʱ룬ͨĽ
+    MazePath path;         // ·--pathsʱ
+} SolveResult;
+
+// Ĺ
+typedef struct {
+    const SolverOptions* opt;
+    const FileList* files;
+    SolveResult* results;
+} SolveJob;
+
+static const char* SolveStatusName(SolveStatus status) {
+    static const char* names[SOLVE_STATUS_COUNT] = { "solved", "no_path", "load_failed", "error" };
+    return (status >= 0 && status < SOLVE_STATUS_COUNT) ? names[status] : "unknown";
+}
+
+static const char* OutputFormatName(OutputFormat format) {
+    static const char* names[OUTPUT_FORMAT_COUNT] = { "text", "csv", "json", "jsonl" };
+    return (format >= 0 && format < OUTPUT_FORMAT_COUNT) ? names[format] : "unknown";
+}
+
+// ԴСдȽ
+static bool EqualsIgnoreCase(const char* a, const char* b) {
+    for (; *a != '\0' && *b != '\0'; a++, b++) {
+        char ca = (*a >= 'A' && *a <= 'Z') ? (char)(*a - 'A' + 'a') : *a;
+        char cb = (*b >= 'A' && *b <= 'Z') ? (char)(*b - 'A' + 'a') : *b;
+        if (ca != cb) return false;
+    }
+    return *a == *b;
+}
+
+// ַʧܷNULL
+static char* CopyString(const char* text) {
+    size_t length = strlen(text);
+    char* copy = (char*)malloc(length + 1);
+    if (copy == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣļ·");
+        return NULL;
+    }
+    memcpy(copy, text, length + 1);
+    return copy;
+}
+
+// ƴĿ¼ļĿ¼ĩβзָʱӣ
+static char* JoinPath(const char* dir, const char* name) {
+    size_t dirLength = strlen(dir);
+    size_t nameLength = strlen(name);
+    bool separated = dirLength > 0 && (dir[dirLength - 1] == '/' || dir[dirLength - 1] == '\\');
+    char* path = (char*)malloc(dirLength + nameLength + 2);
+    if (path == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣļ·");
+        return NULL;
+    }
+    memcpy(path, dir, dirLength);
+    if (!separated) {
+#ifdef _WIN32
+        path[dirLength++] = '\\';
+#else
+        path[dirLength++] = '/';
+#endif
+    }
+    memcpy(path + dirLength, name, nameLength + 1);
+    return path;
+}
+
+// ļǷָչβԴСдextensionΪNULLʱƥ䣩
+static bool HasExtension(const char* name, const char* extension) {
+    if (extension == NULL) return true;
+    size_t nameLength = strlen(name);
+    size_t extLength = strlen(extension);
+    return nameLength >= extLength && EqualsIgnoreCase(name + nameLength - extLength, extension);
+}
+
+// ·бӹpathڴ棬ݣ
+static bool FileListAdd(FileList* list, char* path) {
+    if (path == NULL) return false;
+    if (list->count == list->capacity) {
+        int capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+        char** grown = (char**)realloc(list->paths, (size_t)capacity * sizeof(char*));
+        if (grown == NULL) {
+            TraceLog(LOG_ERROR, "ڴʧܣļб%d", capacity);
+            free(path);
+            return false;
+        }
+        list->paths = grown;
+        list->capacity = capacity;
+    }
+    list->paths[list->count++] = path;
+    return true;
+}
+
+static void FileListFree(FileList* list) {
+    for (int i = 0; i < list->count; i++) {
+        free(list->paths[i]);
+    }
+    free(list->paths);
+    list->paths = NULL;
+    list->count = 0;
+    list->capacity = 0;
+}
+
+static int ComparePaths(const void* a, const void* b) {
+    return strcmp(*(const char* const*)a, *(const char* const*)b);
+}
+
+static bool IsDirectory(const char* path) {
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(path);
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+#else
+    struct stat info;
+    return stat(path, &info) == 0 && S_ISDIR(info.st_mode);
+#endif
+}
+
+// ɨĿ¼ļбĿ¼--recursiveʱڱĿ¼ļ֮
+static bool CollectDirectory(FileList* list, const char* dir, const SolverOptions* opt) {
+    FileList subdirs = { NULL, 0, 0 };
+    int first = list->count;
+    bool ok = true;
+#ifdef _WIN32
+    char* pattern = JoinPath(dir, "*");
+    if (pattern == NULL) return false;
+    WIN32_FIND_DATAA entry;
+    HANDLE find = FindFirstFileA(pattern, &entry);
+    free(pattern);
+    if (find == INVALID_HANDLE_VALUE) {
+        TraceLog(LOG_ERROR, "޷Ŀ¼: %s", dir);
+        return false;
+    }
+    do {
+        const char* name = entry.cFileName;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+        if ((entry.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0) {
+            if (opt->recursive) ok = FileListAdd(&subdirs, JoinPath(dir, name)) && ok;
+        }
+        else if (HasExtension(name, opt->extension)) {
+            ok = FileListAdd(list, JoinPath(dir, name)) && ok;
+        }
+    } while (ok && FindNextFileA(find, &entry));
+    FindClose(find);
+#else
+    DIR* handle = opendir(dir);
+    if (handle == NULL) {
+        TraceLog(LOG_ERROR, "޷Ŀ¼: %s", dir);
+        return false;
+    }
+    struct dirent* entry;
+    while (ok && (entry = readdir(handle)) != NULL) {
+        const char* name = entry->d_name;
+        if (strcmp(name, ".") == 0 || strcmp(name, "..") == 0) continue;
+        char* path = JoinPath(dir, name);
+        if (path == NULL) {
+            ok = false;
+            break;
+        }
+        if (IsDirectory(path)) {
+            if (opt->recursive) ok = FileListAdd(&subdirs, path);
+            else free(path);
+        }
+        else if (HasExtension(name, opt->extension)) {
+            ok = FileListAdd(list, path);
+        }
+        else {
+            free(path);
+        }
+    }
+    closedir(handle);
+#endif
+
+    if (list->count - first > 1) qsort(list->paths + first, (size_t)(list->count - first), sizeof(char*), ComparePaths);
+    if (subdirs.count > 1) qsort(subdirs.paths, (size_t)subdirs.count, sizeof(char*), ComparePaths);
+    for (int i = 0; ok && i < subdirs.count; i++) {
+        ok = CollectDirectory(list, subdirs.paths[i], opt);
+    }
+    FileListFree(&subdirs);
+    return ok;
+}
+
+// һļÿԹ֮䲻дݣ
+static void SolveFileTask(int index, int worker, void* context) {
+    (void)worker;
+    SolveJob* job = (SolveJob*)context;
+    const SolverOptions* opt = job->opt;
+    SolveResult* res = &job->results[index];
+    res->status = SOLVE_ERROR;
+    res->rows = 0;
+    res->cols = 0;
+    res->pathLength = 0;
+    res->pathCost = 0;
+    res->expanded = 0;
+    res->loadMs = 0.0;
+    res->solveMs = 0.0;
+    MazePathInit(&res->path, PATH_DIRECTIONS);
+
+    auto t0 = std::chrono::steady_clock::now();
+    Maze* maze = MazeCreate();
+    if (maze == NULL || !MazeLoadFromFile(maze, job->files->paths[index])) {
+        res->status = SOLVE_LOAD_FAILED;
+        MazeDestroy(maze);
+        return;
+    }
+    auto t1 = std::chrono::steady_clock::now();
+    res->loadMs = std::chrono::duration<double, std::milli>(t1 - t0).count();
+    res->rows = maze->rows;
+    res->cols = maze->cols;
+
+    PathData* pd = PathDataCreate(maze);
+    if (pd == NULL) {
+        MazeDestroy(maze);
+        return;
+    }
+    // ѰļУ轨ͨHPA*ֲͼڱ߳
+    pd->threads = 1;
+    bool found = MazeSolveWith(maze, pd, opt->algo, opt->movement, DEFAULT_TERRAIN_COST);
+    auto t2 = std::chrono::steady_clock::now();
+    res->solveMs = std::chrono::duration<double, std::milli>(t2 - t1).count();
+    res->expanded = pd->expanded;
+    if (!found) {
+        res->status = SOLVE_NO_PATH;
+    }
+    else if ((res->pathLength = PathBacktrack(maze, pd, &res->path)) > 0) {
+        res->pathCost = MazePathCost(maze, &res->path, opt->movement, DEFAULT_TERRAIN_COST);
+        res->status = SOLVE_SOLVED;
+    }
+    if (!opt->paths) MazePathFree(&res->path);
+
+    PathDataDestroy(maze, pd);
+    MazeDestroy(maze);
+}
+
+// ·д𲽷U/D/L/RΪңб߰С̷λΪ7ϣ9ϣ1£3£
+static void WriteMoves(FILE* file, const MazePath* path) {
+    static const char moves[3][3] = { { '7', 'U', '9' }, { 'L', '?', 'R' }, { '1', 'D', '3' } };
+    MazePathIter it;
+    MazePathIterBegin(&it, path);
+    Point prev;
+    Point cell;
+    if (!MazePathIterNext(&it, &prev)) return;
+    while (MazePathIterNext(&it, &cell)) {
+        fputc(moves[cell.y - prev.y + 1][cell.x - prev.x + 1], file);
+        prev = cell;
+    }
+}
+
+// дCSVַżӱ
+static void WriteCsvString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == '"') fputc('"', file);
+        fputc(*p, file);
+    }
+    fputc('"', file);
+}
+
+// дJSONַת뷴бܣ
+static void WriteJsonString(FILE* file, const char* text) {
+    fputc('"', file);
+    for (const char* p = text; *p != '\0'; p++) {
+        if (*p == '"' || *p == '\\') fputc('\\', file);
+        fputc(*p, file);
+    }
+    fputc('"', file);
+}
+
+static void WriteTextRecord(FILE* file, const SolverOptions* opt, const char* name, const SolveResult* r) {
+    char size[32];
+    snprintf(size, sizeof(size), "%dx%d", r->rows, r->cols);
+    fprintf(file, "%-40s %-11s %11s %8d %10lld %10d %9.3f %9.3f\n",
+        name, SolveStatusName(r->status), size, r->pathLength, r->pathCost, r->expanded, r->loadMs, r->solveMs);
+    if (opt->paths && r->status == SOLVE_SOLVED) {
+        fprintf(file, "    path (%d,%d) ", r->path.start.x, r->path.start.y);
+        WriteMoves(file, &r->path);
+        fputc('\n', file);
+    }
+}
+
+static void WriteCsvRecord(FILE* file, const SolverOptions* opt, const char* name, const SolveResult* r) {
+    WriteCsvString(file, name);
+    fprintf(file, ",%d,%d,\"%s\",\"%s\",%s,%d,%lld,%d,%.4f,%.4f",
+        r->rows, r->cols, MazeAlgorithmName(opt->algo), MazeMovementName(opt->movement),
+        SolveStatusName(r->status), r->pathLength, r->pathCost, r->expanded, r->loadMs, r->solveMs);
+    if (opt->paths) {
+        if (r->status == SOLVE_SOLVED) {
+            fprintf(file, ",%d,%d,", r->path.start.x, r->path.start.y);
+            WriteMoves(file, &r->path);
+        }
+        else {
+            fprintf(file, ",,,");
+        }
+    }
+    fputc('\n', file);
+}
+
+// ԹJSONJSONJSON LinesãУ
+static void WriteJsonRecord(FILE* file, const SolverOptions* opt, const char* name, const SolveResult* r) {
+    fprintf(file, "{\"maze\": ");
+    WriteJsonString(file, name);
+    fprintf(file, ", \"rows\": %d, \"cols\": %d, \"algorithm\": ", r->rows, r->cols);
+    WriteJsonString(file, MazeAlgorithmName(opt->algo));
+    fprintf(file, ", \"movement\": \"%s\", \"status\": \"%s\", \"path_length\": %d, \"path_cost\": %lld, "
+        "\"expanded\": %d, \"load_ms\": %.4f, \"solve_ms\": %.4f",
+        MazeMovementName(opt->movement), SolveStatusName(r->status), r->pathLength, r->pathCost,
+        r->expanded, r->loadMs, r->solveMs);
+    if (opt->paths && r->status == SOLVE_SOLVED) {
+        fprintf(file, ", \"start\": [%d, %d], \"moves\": \"", r->path.start.x, r->path.start.y);
+        WriteMoves(file, &r->path);
+        fputc('"', file);
+    }
+    fputc('}', file);
+}
+
+static bool WriteResults(const SolverOptions* opt, const FileList* files, const SolveResult* results) {
+    FILE* file = stdout;
+    if (opt->outPath != NULL) {
+        file = MazeFileOpen(opt->outPath, "w");
+        if (file == NULL) {
+            TraceLog(LOG_ERROR, "޷дļ: %s", opt->outPath);
+            return false;
+        }
+    }
+
+    if (opt->format == OUTPUT_TEXT) {
+        fprintf(file, "%-40s %-11s %11s %8s %10s %10s %9s %9s\n",
+            "maze", "status", "size", "length", "cost", "expanded", "load_ms", "solve_ms");
+    }
+    else if (opt->format == OUTPUT_CSV) {
+        fprintf(file, "maze,rows,cols,algorithm,movement,status,path_length,path_cost,expanded,load_ms,solve_ms%s\n",
+            opt->paths ? ",start_x,start_y,moves" : "");
+    }
+    else if (opt->format == OUTPUT_JSON) {
+        fprintf(file, "{\n  \"schema\": 1,\n  \"algorithm\": ");
+        WriteJsonString(file, MazeAlgorithmName(opt->algo));
+        fprintf(file, ",\n  \"movement\": \"%s\",\n  \"results\": [\n", MazeMovementName(opt->movement));
+    }
+
+    for (int i = 0; i < files->count; i++) {
+        const char* name = files->paths[i];
+        switch (opt->format) {
+        case OUTPUT_TEXT:
+            WriteTextRecord(file, opt, name, &results[i]);
+            break;
+        case OUTPUT_CSV:
+            WriteCsvRecord(file, opt, name, &results[i]);
+            break;
+        case OUTPUT_JSON:
+            fprintf(file, "    ");
+            WriteJsonRecord(file, opt, name, &results[i]);
+            fprintf(file, "%s\n", i + 1 < files->count ? "," : "");
+            break;
+        default:
+            WriteJsonRecord(file, opt, name, &results[i]);
+            fputc('\n', file);
+            break;
+        }
+    }
+    if (opt->format == OUTPUT_JSON) fprintf(file, "  ]\n}\n");
+
+    if (file == stdout) return fflush(file) == 0;
+    return fclose(file) == 0;
+}
+
+static bool ParseAlgorithm(const char* text, SolverOptions* opt) {
+    for (int a = ALGO_NONE + 1; a < ALGO_COUNT; a++) {
+        if (EqualsIgnoreCase(text, MazeAlgorithmName((MazeAlgorithm)a))) {
+            opt->algo = (MazeAlgorithm)a;
+            return true;
+        }
+    }
+    // Ϸеּһ
+    char* end = NULL;
+    long value = strtol(text, &end, 10);
+    if (end == text || *end != '\0' || value <= ALGO_NONE || value >= ALGO_COUNT) return false;
+    opt->algo = (MazeAlgorithm)value;
+    return true;
+}
+
+static bool ParseMovement(const char* text, SolverOptions* opt) {
+    for (int m = 0; m < MOVE_COUNT; m++) {
+        if (EqualsIgnoreCase(text, MazeMovementName((MazeMovement)m))) {
+            opt->movement = (MazeMovement)m;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool ParseFormat(const char* text, SolverOptions* opt) {
+    for (int f = 0; f < OUTPUT_FORMAT_COUNT; f++) {
+        if (EqualsIgnoreCase(text, OutputFormatName((OutputFormat)f))) {
+            opt->format = (OutputFormat)f;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void PrintUsage() {
+    printf("÷: MazeSolver [ѡ] ļĿ¼...\n");
+    printf("  --algo NAME|N         Ѱ·㷨ƻţĬA*");
+    for (int a = ALGO_NONE + 1; a < ALGO_COUNT; a++) {
+        printf("%s%d=%s", a > 1 ? " " : "", a, MazeAlgorithmName((MazeAlgorithm)a));
+    }
+    printf("\n");
+    printf("  --moves M             ƶʽ4Ĭϣ/8˷򣬲ǽǣ/8cut˷ǽǣ\n");
+    printf("  --format F            ʽtextĬϣ/csv/json/jsonl\n");
+    printf("  --out PATH            дļĬϱ׼\n");
+    printf("  --threads N           ߳Ĭ0ȫӲ̣߳\n");
+    printf("  --paths               ͬʱ·𲽷U/D/L/RбΪ7/9/1/3\n");
+    printf("  --recursive           ݹɨĿ¼\n");
+    printf("  --ext EXT             ɨĿ¼ʱֻȡչļ.txtĬȫļ\n");
+    printf("  --verbose             ̵־\n");
+}
+
+static bool ParseOptions(int argc, char** argv, SolverOptions* opt, bool* verbose) {
+    opt->inputs = (char**)malloc((size_t)argc * sizeof(char*));
+    opt->inputCount = 0;
+    opt->algo = ALGO_ASTAR;
+    opt->movement = MOVE_4;
+    opt->format = OUTPUT_TEXT;
+    opt->outPath = NULL;
+    opt->threads = 0;
+    opt->paths = false;
+    opt->recursive = false;
+    opt->extension = NULL;
+    *verbose = false;
+    if (opt->inputs == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣб");
+        return false;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "-h") == 0 || strcmp(arg, "--help") == 0) return false;
+        if (strncmp(arg, "--", 2) != 0) {
+            opt->inputs[opt->inputCount++] = argv[i];
+            continue;
+        }
+        // ز
+        if (strcmp(arg, "--paths") == 0) {
+            opt->paths = true;
+            continue;
+        }
+        if (strcmp(arg, "--recursive") == 0) {
+            opt->recursive = true;
+            continue;
+        }
+        if (strcmp(arg, "--verbose") == 0) {
+            *verbose = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            TraceLog(LOG_ERROR, "ȱȡֵ: %s", arg);
+            return false;
+        }
+        const char* value = argv[++i];
+        bool ok = true;
+        if (strcmp(arg, "--algo") == 0) ok = ParseAlgorithm(value, opt);
+        else if (strcmp(arg, "--moves") == 0) ok = ParseMovement(value, opt);
+        else if (strcmp(arg, "--format") == 0) ok = ParseFormat(value, opt);
+        else if (strcmp(arg, "--out") == 0) opt->outPath = value;
+        else if (strcmp(arg, "--threads") == 0) opt->threads = atoi(value);
+        else if (strcmp(arg, "--ext") == 0) opt->extension = value;
+        else {
+            TraceLog(LOG_ERROR, "δ֪: %s", arg);
+            return false;
+        }
+        if (!ok) {
+            TraceLog(LOG_ERROR, "ȡֵǷ: %s %s", arg, value);
+            return false;
+        }
+    }
+
+    if (opt->inputCount == 0) {
+        TraceLog(LOG_ERROR, "δָԹļĿ¼");
+        return false;
+    }
+    if (!MazeAlgorithmSupports(opt->algo, opt->movement)) {
+        TraceLog(LOG_ERROR, "%s֧ƶʽ%s", MazeAlgorithmName(opt->algo), MazeMovementName(opt->movement));
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    SolverOptions opt;
+    bool verbose;
+    if (!ParseOptions(argc, argv, &opt, &verbose)) {
+        PrintUsage();
+        free(opt.inputs);
+        return 1;
+    }
+    // ÿļļ־ǧļʱֻϢ
+    if (!verbose) SetTraceLogLevel(LOG_ERROR);
+
+    auto begin = std::chrono::steady_clock::now();
+    FileList files = { NULL, 0, 0 };
+    bool ok = true;
+    for (int i = 0; ok && i < opt.inputCount; i++) {
+        if (IsDirectory(opt.inputs[i])) ok = CollectDirectory(&files, opt.inputs[i], &opt);
+        else ok = FileListAdd(&files, CopyString(opt.inputs[i]));
+    }
+    free(opt.inputs);
+    if (!ok || files.count == 0) {
+        if (ok) TraceLog(LOG_ERROR, "ûҵԹļ");
+        FileListFree(&files);
+        return 1;
+    }
+
+    SolveResult* results = (SolveResult*)malloc((size_t)files.count * sizeof(SolveResult));
+    ParallelPool* pool = ParallelPoolCreate(opt.threads);
+    if (results == NULL || pool == NULL) {
+        TraceLog(LOG_ERROR, "ڴʧܣ%dļ", files.count);
+        ParallelPoolDestroy(pool);
+        free(results);
+        FileListFree(&files);
+        return 1;
+    }
+    SolveJob job = { &opt, &files, results };
+    ParallelPoolRun(pool, files.count, SolveFileTask, &job);
+    int threads = ParallelPoolThreadCount(pool);
+    ParallelPoolDestroy(pool);
+    double totalMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    ok = WriteResults(&opt, &files, results);
+    int counts[SOLVE_STATUS_COUNT] = { 0 };
+    for (int i = 0; i < files.count; i++) {
+        counts[results[i].status]++;
+        MazePathFree(&results[i].path);
+    }
+    fprintf(stderr, "%dԹɴ%dɴ%dʧ%d%d%s%ḍ߳%.1f룩\n",
+        files.count, counts[SOLVE_SOLVED], counts[SOLVE_NO_PATH], counts[SOLVE_LOAD_FAILED], counts[SOLVE_ERROR],
+        MazeAlgorithmName(opt.algo), threads, totalMs);
+
+    int exitCode = !ok ? 1 : (counts[SOLVE_SOLVED] == files.count ? 0 : 2);
+    free(results);
+    FileListFree(&files);
+    return exitCode;
+}